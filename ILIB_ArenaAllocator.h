@@ -19,8 +19,12 @@
 #include "ILIB_Vector.h"
 
 
+#ifndef __cplusplus
 #define nullptr                    ((void*)0)
+#endif
 #define STD_ARENA_SIZE             (1024 * 4)
+#define STD_ARENA_MAX_SIZE         (1024 * 1024 * 64)  // New arenas stop doubling at this size.
+#define STD_ARENA_GROWTH           (2)
 #define STD_ARENA_MEMORY_ALIGNMENT (16)
 
 
@@ -29,15 +33,15 @@
 typedef struct Arena_t
 {
     void*    m_pMemory;   // malloc-ed memory.
-    uint32_t m_iSize;     // Total size of arena in bytes.
-    uint32_t m_iUsedTill; // Bytes used in arena.
+    uint64_t m_iSize;     // Total size of arena in bytes.
+    uint64_t m_iUsedTill; // Bytes used in arena.
     
 } Arena_t;
 
 
 /* Allocate memory to arena and set up internal variables. Using an uninitialized arena
    WILL cause errors. */
-static bool Arena_Initialize(Arena_t* pArena, uint32_t iArenaSize);
+static bool Arena_Initialize(Arena_t* pArena, uint64_t iArenaSize);
 
 /* Get memory of a fixed size from arena. Returns 0 on failure. */
 static void* Arena_Allocate(Arena_t* pArena, size_t nBytes);
@@ -62,58 +66,52 @@ static size_t Arena_Capacity(Arena_t* pArena);
 
 
 
-///////////////////////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////
-typedef struct AAMallocInfo_t
-{ 
-    void*  m_pMemory;  // Pointer to malloc-ed memory.
-    size_t m_iSize;    // Size of malloc-ed region.
-
-} AAMallocInfo_t;
-
-
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
 typedef struct ArenaAllocator_t
 {
-    Arena_t* m_pArenas;    // ISTDLIB vector of Arena_t objects
-    size_t   m_iArenaSize; // Common arena capacity in bytes.
-
-    struct AAMallocInfo_t* m_pMallocs;
+    Arena_t* m_pArenas;        // ISTDLIB vector of Arena_t objects
+    size_t   m_iArenaSize;     // Capacity of arenas created on initialization.
+    size_t   m_iNextArenaSize; // Capacity of next arena we push back. Grows by STD_ARENA_GROWTH upto m_iMaxArenaSize.
+    size_t   m_iMaxArenaSize;  // Cap on m_iNextArenaSize.
 
 } ArenaAllocator_t;
 
 
-/* Initialie ArenaAllocator with NARENA number of arenas with IARENASIZE capacity of each arena. */
+/* Initialie ArenaAllocator with NARENA number of arenas with IARENASIZE capacity of each arena.
+ * Arenas pushed back later double in size each time, starting from 2 * IARENASIZE, upto STD_ARENA_MAX_SIZE. */
 static bool ArenaAllocator_Initialize(ArenaAllocator_t* pArenaAlloc, int nArenas, size_t iArenaSize);
 
+/* Cap growth of new arenas at IMAXARENASIZE bytes. Passing initial arena size turns growth off. */
+static void ArenaAllocator_SetMaxArenaSize(ArenaAllocator_t* pArenaAlloc, size_t iMaxArenaSize);
+
 /* Allocate NBYTES bytes in the first arena that can allcoate.
- * If NBYTES is more than arena capacity, than malloc and store its information.
- * If NBYTES is less than arena capacity but no arena can allocate NBYTES, push back new arena & allocate. */
+ * If no arena can allocate NBYTES, push back a new arena of next arena size ( or NBYTES if bigger ) & allocate.
+ * If NBYTES is more than max arena size, push back a dedicated arena of exactly NBYTES. */
 static void* ArenaAllocator_Allocate(ArenaAllocator_t* pArenaAlloc, size_t nBytes);
 
-/* Handles allocation requests where NBYTES is more than arena capacity. Mallocs NBYTES. */
-static void* ArenaAllocator_Malloc(ArenaAllocator_t* pArenaAlloc, size_t nBytes);
+/* Handles allocation requests where NBYTES is more than max arena size. Pushes back a full arena of NBYTES. */
+static void* ArenaAllocator_AllocateDedicated(ArenaAllocator_t* pArenaAlloc, size_t nBytes);
 
-/* Mark all arenas as empty. Doesn't modify malloc-ed entries in any way. */
+/* Mark all arenas as empty. Dedicated arenas are reused like any other arena after this. */
 static void ArenaAllocator_Clear(ArenaAllocator_t* pArenaAlloc);
 
-/* Memset() all arenas in this arena allocator and CLEAR all arenas. Mallocs remain untouched. */
+/* Memset() all arenas in this arena allocator and CLEAR all arenas. */
 static void ArenaAllocator_Memset(ArenaAllocator_t* pArenaAlloc, int iData);
 
-/* Free all arenas & malloc-ed memories and uninitialize this ArenaAllocator. */
+/* Free all arenas and uninitialize this ArenaAllocator. */
 static void ArenaAllocator_Free(ArenaAllocator_t* pArenaAlloc);
 
 /* Combined bytes consumed across all arenas in this ArenaAllocator. */
 static size_t ArenaAllocator_Size(ArenaAllocator_t* pArenaAlloc);
 
-/* Combined bytes consumed across all arenas + malloc-ed entries in this ArenaAllocator. */
+/* Same as ArenaAllocator_Size(), large allocations live in arenas too now. */
 static size_t ArenaAllocator_SizeAll(ArenaAllocator_t* pArenaAlloc);
 
 /* Combined capacity across all arenas in this ArenaAllocator. */
 static size_t ArenaAllocator_Capacity(ArenaAllocator_t* pArenaAlloc);
 
-/* Size of one arena in bytes. All arenas are of same size. */
+/* Capacity the next pushed back arena will get. */
 static size_t ArenaAllocator_ArenaCapacity(ArenaAllocator_t* pArenaAlloc);
 
 /* Number of arenas in this ArenaAllocator. */
@@ -123,11 +121,11 @@ static size_t ArenaAllocator_ArenaCount(ArenaAllocator_t* pArenaAlloc);
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static bool Arena_Initialize(Arena_t* pArena, uint32_t iArenaSize)
+static bool Arena_Initialize(Arena_t* pArena, uint64_t iArenaSize)
 {
     pArena->m_iSize     = iArenaSize == 0 ? STD_ARENA_SIZE : iArenaSize;
     pArena->m_iUsedTill = 0;
-    pArena->m_pMemory   = malloc(iArenaSize);
+    pArena->m_pMemory   = malloc(pArena->m_iSize);
 
     return pArena->m_pMemory != nullptr;
 }
@@ -155,15 +153,14 @@ static void* Arena_Allocate(Arena_t* pArena, size_t nBytes)
     size_t iBytesUsedAligned = iAlignedPointer - (size_t)pArena->m_pMemory;
 
 
-    // We have enough capacity according to aligned memory ?
-    int64_t iCapacity = (int64_t)pArena->m_iSize - (int64_t)iBytesUsedAligned;
-    if(nBytes > iCapacity)
+    // We have enough capacity according to aligned memory ? ( aligning can push us past the end )
+    if(iBytesUsedAligned > pArena->m_iSize || nBytes > pArena->m_iSize - iBytesUsedAligned)
         return nullptr;
 
 
     assertion(
             iAlignedPointer >= (size_t)pArena->m_pMemory && 
-            iAlignedPointer <  (size_t)pArena->m_pMemory + (size_t)pArena->m_iSize && 
+            iAlignedPointer <= (size_t)pArena->m_pMemory + (size_t)pArena->m_iSize && 
             "Invalid aligned pointer");
 
     pArena->m_iUsedTill = iBytesUsedAligned + nBytes;
@@ -236,9 +233,16 @@ static bool ArenaAllocator_Initialize(ArenaAllocator_t* pArenaAlloc, int nArenas
         return false;
 
 
-    pArenaAlloc->m_pArenas    = NULL;
-    pArenaAlloc->m_iArenaSize = iArenaSize;
-    pArenaAlloc->m_pMallocs   = NULL;
+    if(iArenaSize == 0)
+        iArenaSize = STD_ARENA_SIZE;
+
+    pArenaAlloc->m_pArenas        = NULL;
+    pArenaAlloc->m_iArenaSize     = iArenaSize;
+    pArenaAlloc->m_iMaxArenaSize  = iArenaSize > STD_ARENA_MAX_SIZE ? iArenaSize : STD_ARENA_MAX_SIZE;
+    pArenaAlloc->m_iNextArenaSize = iArenaSize * STD_ARENA_GROWTH;
+
+    if(pArenaAlloc->m_iNextArenaSize > pArenaAlloc->m_iMaxArenaSize)
+        pArenaAlloc->m_iNextArenaSize = pArenaAlloc->m_iMaxArenaSize;
 
     
     // PushBack and iniitalize arenas.
@@ -277,6 +281,20 @@ static bool ArenaAllocator_Initialize(ArenaAllocator_t* pArenaAlloc, int nArenas
 }
 
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ArenaAllocator_SetMaxArenaSize(ArenaAllocator_t* pArenaAlloc, size_t iMaxArenaSize)
+{
+    if(iMaxArenaSize < pArenaAlloc->m_iArenaSize)
+        iMaxArenaSize = pArenaAlloc->m_iArenaSize;
+
+    pArenaAlloc->m_iMaxArenaSize = iMaxArenaSize;
+
+    if(pArenaAlloc->m_iNextArenaSize > iMaxArenaSize)
+        pArenaAlloc->m_iNextArenaSize = iMaxArenaSize;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
 static void* ArenaAllocator_Allocate(ArenaAllocator_t* pArenaAlloc, size_t nBytes)
@@ -287,11 +305,6 @@ static void* ArenaAllocator_Allocate(ArenaAllocator_t* pArenaAlloc, size_t nByte
         return nullptr;
 
 
-    // nBytes is more than max arena capacity, malloc nBytes and return it.
-    if(nBytes > pArenaAlloc->m_iArenaSize)
-        return ArenaAllocator_Malloc(pArenaAlloc, nBytes);
-
-
     // Allocate from the first arena that can allocate.
     for(int iArenaIndex = 0; iArenaIndex < Vector_Len(pArenaAlloc->m_pArenas); iArenaIndex++)
     {
@@ -303,29 +316,39 @@ static void* ArenaAllocator_Allocate(ArenaAllocator_t* pArenaAlloc, size_t nByte
     }
 
 
-    // In case no arena is capable of allocating, pushback new arena.
-    Vector_PushBack(pArenaAlloc->m_pArenas, (Arena_t){0});
-    if(Arena_Initialize(Vector_Back(pArenaAlloc->m_pArenas), pArenaAlloc->m_iArenaSize) == false)
+    // nBytes is more than even the biggest arena could hold, give it an arena of its own.
+    if(nBytes > pArenaAlloc->m_iMaxArenaSize)
+        return ArenaAllocator_AllocateDedicated(pArenaAlloc, nBytes);
+
+
+    // In case no arena is capable of allocating, pushback new arena. Each one is bigger than the
+    // last ( & than nBytes ), so arena count stays logarithmic in bytes allocated.
+    size_t iNewArenaSize = nBytes > pArenaAlloc->m_iNextArenaSize ? nBytes : pArenaAlloc->m_iNextArenaSize;
+
+    Arena_t newArena = {0};
+    if(Arena_Initialize(&newArena, iNewArenaSize) == false)
         return nullptr;
 
+    Vector_PushBack(pArenaAlloc->m_pArenas, newArena);
+
+    size_t iGrownSize = iNewArenaSize * STD_ARENA_GROWTH;
+    pArenaAlloc->m_iNextArenaSize = iGrownSize < pArenaAlloc->m_iMaxArenaSize ? iGrownSize : pArenaAlloc->m_iMaxArenaSize;
+
     return Arena_Allocate(Vector_Back(pArenaAlloc->m_pArenas), nBytes);
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void* ArenaAllocator_Malloc(ArenaAllocator_t* pArenaAlloc, size_t nBytes)
+static void* ArenaAllocator_AllocateDedicated(ArenaAllocator_t* pArenaAlloc, size_t nBytes)
 {
-    AAMallocInfo_t mallocInfo = {0};
-
-    mallocInfo.m_pMemory = malloc(nBytes);
-    mallocInfo.m_iSize   = nBytes;
-
-    if(mallocInfo.m_pMemory == nullptr)
+    // Exactly nBytes, malloc-ed memory is already aligned so it fills the arena completely.
+    Arena_t dedicatedArena = {0};
+    if(Arena_Initialize(&dedicatedArena, nBytes) == false)
         return nullptr;
 
-    Vector_PushBack(pArenaAlloc->m_pMallocs, mallocInfo);
-    return mallocInfo.m_pMemory;
+    Vector_PushBack(pArenaAlloc->m_pArenas, dedicatedArena);
+    return Arena_Allocate(Vector_Back(pArenaAlloc->m_pArenas), nBytes);
 }
 
 
@@ -361,14 +384,7 @@ static void ArenaAllocator_Free(ArenaAllocator_t* pArenaAlloc)
         Arena_Free(&pArenaAlloc->m_pArenas[iArenaIndex]);
     }
 
-    // Free malloc-ed entries.
-    for(int iMallocIndex = 0; iMallocIndex < Vector_Len(pArenaAlloc->m_pMallocs); iMallocIndex++)
-    {
-        free(pArenaAlloc->m_pMallocs[iMallocIndex].m_pMemory);
-    }
-
     Vector_Free(pArenaAlloc->m_pArenas);
-    Vector_Free(pArenaAlloc->m_pMallocs);
 }
 
 
@@ -391,14 +407,7 @@ static size_t ArenaAllocator_Size(ArenaAllocator_t* pArenaAlloc)
 ///////////////////////////////////////////////////////////////////////////
 static size_t ArenaAllocator_SizeAll(ArenaAllocator_t* pArenaAlloc)
 {
-    size_t iTotalSize = ArenaAllocator_Size(pArenaAlloc);
-
-    for(int iMallocIndex = 0; iMallocIndex < Vector_Len(pArenaAlloc->m_pMallocs); iMallocIndex++)
-    {
-        iTotalSize += pArenaAlloc->m_pMallocs[iMallocIndex].m_iSize;
-    }
-
-    return iTotalSize;
+    return ArenaAllocator_Size(pArenaAlloc);
 }
 
 
@@ -421,7 +430,7 @@ static size_t ArenaAllocator_Capacity(ArenaAllocator_t* pArenaAlloc)
 ///////////////////////////////////////////////////////////////////////////
 static size_t ArenaAllocator_ArenaCapacity(ArenaAllocator_t* pArenaAlloc)
 {
-    return pArenaAlloc->m_iArenaSize;
+    return pArenaAlloc->m_iNextArenaSize;
 }
 
 
@@ -0,0 +1,690 @@
+//=========================================================================
+//                      ILIB BTree
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Arena allocated B+tree in C. Ordered int64_t -> uint64_t map
+//           with SIMD search inside nodes & linked leaves for range scans.
+//-------------------------------------------------------------------------
+#ifndef ILIB_BTREE_H
+#define ILIB_BTREE_H
+
+
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+#include "ILIB_ArenaAllocator.h"
+
+
+#ifndef __cplusplus
+#define nullptr                 ((void*)0)
+#define BTREE_ALIGNAS(x)        _Alignas(x)
+#else
+#define BTREE_ALIGNAS(x)        alignas(x)
+#endif
+#define BTREE_MAX_KEYS          (16)                        // Keys per node. Multiple of 4, so AVX2 compares cover it exactly.
+#define BTREE_BULK_FILL         (BTREE_MAX_KEYS * 3 / 4)    // Keys per node on bulk load, leaves room for later inserts.
+#define BTREE_MAX_HEIGHT        (16)
+#define BTREE_NODE_ALIGNMENT    (64)
+#define BTREE_NODES_PER_BLOCK   (256)                       // Nodes are carved out of arena allocations this big.
+#define BTREE_EMPTY_KEY         (INT64_MAX)                 // Unused key slots, never compares smaller than a real key.
+
+/*
+
+BTree Structure :
+                    [ Inner ]
+                   /    |    \
+            [ Inner ] [ Inner ] [ Inner ]
+              /  \       ...        \
+        [ Leaf ]->[ Leaf ]-> ... ->[ Leaf ]
+
+Inner key i is the smallest key in child i + 1. Leaves hold key / value pairs and
+link to the next leaf, so range scans never go back up the tree.
+
+Nodes are BTREE_NODE_ALIGNMENT aligned & a whole number of cache lines. Unused key slots
+hold BTREE_EMPTY_KEY, so searching a node compares all BTREE_MAX_KEYS slots without branches.
+Nodes are allocated in blocks from the tree's own ArenaAllocator_t, bulk loaded leaves end
+up one after another in memory.
+
+Erase is lazy, keys are removed from their leaf but nodes are never merged or freed.
+Nodes come back on BTree_Clear() / BTree_Free().
+
+*/
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct BTreeLeaf_t
+{
+    BTREE_ALIGNAS(BTREE_NODE_ALIGNMENT) int64_t m_aKeys[BTREE_MAX_KEYS];
+
+    uint64_t            m_aValues[BTREE_MAX_KEYS];
+    struct BTreeLeaf_t* m_pNext;   // Leaf with next bigger keys, nullptr for last leaf.
+    uint32_t            m_nKeys;
+
+} BTreeLeaf_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct BTreeInner_t
+{
+    BTREE_ALIGNAS(BTREE_NODE_ALIGNMENT) int64_t m_aKeys[BTREE_MAX_KEYS];
+
+    void*    m_apChildren[BTREE_MAX_KEYS + 1]; // Inner nodes or leaves, depending on level.
+    uint32_t m_nKeys;                          // Child count is m_nKeys + 1.
+
+} BTreeInner_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct BTree_t
+{
+    void*            m_pRoot;        // Leaf if m_iHeight is 1, else inner node.
+    BTreeLeaf_t*     m_pFirstLeaf;
+    uint32_t         m_iHeight;      // 0 when empty.
+    uint64_t         m_nKeys;
+
+    uint8_t*         m_pBlock;       // Block we are carving nodes out of.
+    uint32_t         m_nBlockNodes;  // Nodes left in m_pBlock.
+
+    ArenaAllocator_t m_arenaAlloc;
+
+} BTree_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct BTreeIterator_t
+{
+    BTreeLeaf_t* m_pLeaf;   // nullptr once past the end.
+    uint32_t     m_iIndex;
+
+} BTreeIterator_t;
+
+
+/* Initialize empty tree & its node arena. */
+static bool BTree_Initialize(BTree_t* pTree);
+
+/* Free all nodes and uninitialize this BTree. */
+static void BTree_Free(BTree_t* pTree);
+
+/* Remove all keys. Node memory is kept for reuse. */
+static void BTree_Clear(BTree_t* pTree);
+
+/* Number of keys stored. */
+static uint64_t BTree_Len(BTree_t* pTree);
+
+/* Insert IKEY -> IVALUE, overwriting value if IKEY is already present. O(log n). */
+static void BTree_Insert(BTree_t* pTree, int64_t iKey, uint64_t iValue);
+
+/* Pointer to value of IKEY, nullptr if not present. */
+static uint64_t* BTree_Find(BTree_t* pTree, int64_t iKey);
+
+/* Remove IKEY. Returns false if not present. */
+static bool BTree_Erase(BTree_t* pTree, int64_t iKey);
+
+/* Replace contents with ILIB vector PKEYS ( strictly ascending ) & PVALUES. PVALUES = nullptr stores each key's index. O(n). */
+static void BTree_BulkLoad(BTree_t* pTree, const int64_t* pKeys, const uint64_t* pValues);
+
+/* Iterator at smallest key. */
+static BTreeIterator_t BTree_Begin(BTree_t* pTree);
+
+/* Iterator at first key >= IKEY. */
+static BTreeIterator_t BTree_LowerBound(BTree_t* pTree, int64_t iKey);
+
+/* Is iterator pointing at a key ? */
+static bool BTreeIterator_Valid(BTreeIterator_t* pIterator);
+
+/* Move to next bigger key. */
+static void BTreeIterator_Next(BTreeIterator_t* pIterator);
+
+/* Key under iterator. */
+static int64_t BTreeIterator_Key(BTreeIterator_t* pIterator);
+
+/* Pointer to value under iterator. */
+static uint64_t* BTreeIterator_Value(BTreeIterator_t* pIterator);
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline uint32_t BTree_CountLess(const int64_t* pKeys, int64_t iKey)
+{
+    // Number of key slots < IKEY. Empty slots never count.
+#if defined(__AVX2__)
+    __m256i  target = _mm256_set1_epi64x(iKey);
+    uint32_t nLess  = 0;
+    for(int iSlot = 0; iSlot < BTREE_MAX_KEYS; iSlot += 4)
+    {
+        __m256i keys = _mm256_load_si256((const __m256i*)&pKeys[iSlot]);
+        nLess += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(target, keys))));
+    }
+    return nLess;
+
+#elif defined(__SSE4_2__)
+    __m128i  target = _mm_set1_epi64x(iKey);
+    uint32_t nLess  = 0;
+    for(int iSlot = 0; iSlot < BTREE_MAX_KEYS; iSlot += 2)
+    {
+        __m128i keys = _mm_load_si128((const __m128i*)&pKeys[iSlot]);
+        nLess += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(target, keys))));
+    }
+    return nLess;
+
+#else
+    // Branchless, compilers vectorize this fine too.
+    uint32_t nLess = 0;
+    for(int iSlot = 0; iSlot < BTREE_MAX_KEYS; iSlot++)
+        nLess += (uint32_t)(pKeys[iSlot] < iKey);
+    return nLess;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline uint32_t BTree_ChildIndex(BTreeInner_t* pInner, int64_t iKey)
+{
+    // Child i + 1 starts at key i, so go past every key <= IKEY.
+    uint32_t iChild = pInner->m_nKeys;
+    if(iKey != BTREE_EMPTY_KEY)
+        iChild = BTree_CountLess(pInner->m_aKeys, iKey + 1);
+
+    return iChild < pInner->m_nKeys ? iChild : pInner->m_nKeys;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline uint32_t BTree_LeafIndex(BTreeLeaf_t* pLeaf, int64_t iKey)
+{
+    uint32_t iIndex = BTree_CountLess(pLeaf->m_aKeys, iKey);
+    return iIndex < pLeaf->m_nKeys ? iIndex : pLeaf->m_nKeys;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTree_PadKeys(int64_t* pKeys, uint32_t nKeys)
+{
+    for(uint32_t iSlot = nKeys; iSlot < BTREE_MAX_KEYS; iSlot++)
+        pKeys[iSlot] = BTREE_EMPTY_KEY;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* BTree_NewNode(BTree_t* pTree)
+{
+    size_t iNodeSize = sizeof(BTreeLeaf_t) > sizeof(BTreeInner_t) ? sizeof(BTreeLeaf_t) : sizeof(BTreeInner_t);
+
+    // Grab a new block, arena only aligns to STD_ARENA_MEMORY_ALIGNMENT so over allocate & align ourself.
+    if(pTree->m_nBlockNodes == 0)
+    {
+        uintptr_t pBlock = (uintptr_t)ArenaAllocator_Allocate(&pTree->m_arenaAlloc, iNodeSize * BTREE_NODES_PER_BLOCK + BTREE_NODE_ALIGNMENT);
+        assertion(pBlock != 0 && "Failed to allocate BTree nodes");
+
+        pTree->m_pBlock      = (uint8_t*)(((pBlock + (BTREE_NODE_ALIGNMENT - 1)) / BTREE_NODE_ALIGNMENT) * BTREE_NODE_ALIGNMENT);
+        pTree->m_nBlockNodes = BTREE_NODES_PER_BLOCK;
+    }
+
+    void* pNode = pTree->m_pBlock;
+    pTree->m_pBlock      += iNodeSize;
+    pTree->m_nBlockNodes -= 1;
+
+    return pNode;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static BTreeLeaf_t* BTree_NewLeaf(BTree_t* pTree)
+{
+    BTreeLeaf_t* pLeaf = (BTreeLeaf_t*)BTree_NewNode(pTree);
+    pLeaf->m_pNext = nullptr;
+    pLeaf->m_nKeys = 0;
+    BTree_PadKeys(pLeaf->m_aKeys, 0);
+
+    return pLeaf;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static BTreeInner_t* BTree_NewInner(BTree_t* pTree)
+{
+    BTreeInner_t* pInner = (BTreeInner_t*)BTree_NewNode(pTree);
+    pInner->m_nKeys = 0;
+    BTree_PadKeys(pInner->m_aKeys, 0);
+
+    return pInner;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool BTree_Initialize(BTree_t* pTree)
+{
+    size_t iNodeSize  = sizeof(BTreeLeaf_t) > sizeof(BTreeInner_t) ? sizeof(BTreeLeaf_t) : sizeof(BTreeInner_t);
+    size_t iBlockSize = iNodeSize * BTREE_NODES_PER_BLOCK + BTREE_NODE_ALIGNMENT;
+
+    pTree->m_pRoot       = nullptr;
+    pTree->m_pFirstLeaf  = nullptr;
+    pTree->m_iHeight     = 0;
+    pTree->m_nKeys       = 0;
+    pTree->m_pBlock      = nullptr;
+    pTree->m_nBlockNodes = 0;
+
+    // Arena size is a multiple of alignment, so one block always fits one arena. Later arenas grow & hold many.
+    return ArenaAllocator_Initialize(&pTree->m_arenaAlloc, 1, iBlockSize + STD_ARENA_MEMORY_ALIGNMENT);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTree_Free(BTree_t* pTree)
+{
+    ArenaAllocator_Free(&pTree->m_arenaAlloc);
+
+    pTree->m_pRoot       = nullptr;
+    pTree->m_pFirstLeaf  = nullptr;
+    pTree->m_iHeight     = 0;
+    pTree->m_nKeys       = 0;
+    pTree->m_pBlock      = nullptr;
+    pTree->m_nBlockNodes = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTree_Clear(BTree_t* pTree)
+{
+    ArenaAllocator_Clear(&pTree->m_arenaAlloc);
+
+    pTree->m_pRoot       = nullptr;
+    pTree->m_pFirstLeaf  = nullptr;
+    pTree->m_iHeight     = 0;
+    pTree->m_nKeys       = 0;
+    pTree->m_pBlock      = nullptr;
+    pTree->m_nBlockNodes = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t BTree_Len(BTree_t* pTree)
+{
+    return pTree->m_nKeys;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static BTreeLeaf_t* BTree_FindLeaf(BTree_t* pTree, int64_t iKey)
+{
+    if(pTree->m_iHeight == 0)
+        return nullptr;
+
+    void* pNode = pTree->m_pRoot;
+    for(uint32_t iLevel = 1; iLevel < pTree->m_iHeight; iLevel++)
+    {
+        BTreeInner_t* pInner = (BTreeInner_t*)pNode;
+        pNode = pInner->m_apChildren[BTree_ChildIndex(pInner, iKey)];
+    }
+
+    return (BTreeLeaf_t*)pNode;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTree_Insert(BTree_t* pTree, int64_t iKey, uint64_t iValue)
+{
+    assertion(iKey != BTREE_EMPTY_KEY && "INT64_MAX is reserved for empty key slots");
+
+    if(pTree->m_iHeight == 0)
+    {
+        pTree->m_pFirstLeaf = BTree_NewLeaf(pTree);
+        pTree->m_pRoot      = pTree->m_pFirstLeaf;
+        pTree->m_iHeight    = 1;
+    }
+
+
+    // Walk down, remembering the way back up for splits.
+    BTreeInner_t* apPath[BTREE_MAX_HEIGHT];
+    uint32_t      aiChild[BTREE_MAX_HEIGHT];
+    void*         pNode = pTree->m_pRoot;
+
+    for(uint32_t iLevel = 0; iLevel + 1 < pTree->m_iHeight; iLevel++)
+    {
+        BTreeInner_t* pInner = (BTreeInner_t*)pNode;
+        apPath[iLevel]  = pInner;
+        aiChild[iLevel] = BTree_ChildIndex(pInner, iKey);
+        pNode           = pInner->m_apChildren[aiChild[iLevel]];
+    }
+
+    BTreeLeaf_t* pLeaf  = (BTreeLeaf_t*)pNode;
+    uint32_t     iIndex = BTree_LeafIndex(pLeaf, iKey);
+
+
+    // Already there, overwrite.
+    if(iIndex < pLeaf->m_nKeys && pLeaf->m_aKeys[iIndex] == iKey)
+    {
+        pLeaf->m_aValues[iIndex] = iValue;
+        return;
+    }
+
+    pTree->m_nKeys++;
+
+
+    // Leaf full, move upper half into a new leaf.
+    BTreeLeaf_t* pTarget = pLeaf;
+    BTreeLeaf_t* pRight  = nullptr;
+    if(pLeaf->m_nKeys == BTREE_MAX_KEYS)
+    {
+        uint32_t iHalf = BTREE_MAX_KEYS / 2;
+
+        pRight = BTree_NewLeaf(pTree);
+        memcpy(pRight->m_aKeys,   &pLeaf->m_aKeys[iHalf],   (BTREE_MAX_KEYS - iHalf) * sizeof(int64_t));
+        memcpy(pRight->m_aValues, &pLeaf->m_aValues[iHalf], (BTREE_MAX_KEYS - iHalf) * sizeof(uint64_t));
+        pRight->m_nKeys = BTREE_MAX_KEYS - iHalf;
+        pRight->m_pNext = pLeaf->m_pNext;
+
+        pLeaf->m_nKeys  = iHalf;
+        pLeaf->m_pNext  = pRight;
+        BTree_PadKeys(pLeaf->m_aKeys, iHalf);
+
+        if(iIndex > iHalf)
+        {
+            pTarget = pRight;
+            iIndex -= iHalf;
+        }
+    }
+
+    memmove(&pTarget->m_aKeys[iIndex + 1],   &pTarget->m_aKeys[iIndex],   (pTarget->m_nKeys - iIndex) * sizeof(int64_t));
+    memmove(&pTarget->m_aValues[iIndex + 1], &pTarget->m_aValues[iIndex], (pTarget->m_nKeys - iIndex) * sizeof(uint64_t));
+    pTarget->m_aKeys[iIndex]   = iKey;
+    pTarget->m_aValues[iIndex] = iValue;
+    pTarget->m_nKeys++;
+
+    if(pRight == nullptr)
+        return;
+
+
+    // Push separator up, splitting inner nodes on the way as long as they are full.
+    int64_t iSeparator = pRight->m_aKeys[0];
+    void*   pNewChild  = pRight;
+
+    for(int iLevel = (int)pTree->m_iHeight - 2; iLevel >= 0; iLevel--)
+    {
+        BTreeInner_t* pInner = apPath[iLevel];
+        uint32_t      iSlot  = aiChild[iLevel];
+
+        if(pInner->m_nKeys < BTREE_MAX_KEYS)
+        {
+            memmove(&pInner->m_aKeys[iSlot + 1],      &pInner->m_aKeys[iSlot],      (pInner->m_nKeys - iSlot) * sizeof(int64_t));
+            memmove(&pInner->m_apChildren[iSlot + 2], &pInner->m_apChildren[iSlot + 1], (pInner->m_nKeys - iSlot) * sizeof(void*));
+            pInner->m_aKeys[iSlot]          = iSeparator;
+            pInner->m_apChildren[iSlot + 1] = pNewChild;
+            pInner->m_nKeys++;
+            return;
+        }
+
+
+        // Lay out all keys & children in order, then split around the middle key which moves up.
+        int64_t aKeys[BTREE_MAX_KEYS + 1];
+        void*   apChildren[BTREE_MAX_KEYS + 2];
+
+        memcpy(aKeys, pInner->m_aKeys, iSlot * sizeof(int64_t));
+        aKeys[iSlot] = iSeparator;
+        memcpy(&aKeys[iSlot + 1], &pInner->m_aKeys[iSlot], (BTREE_MAX_KEYS - iSlot) * sizeof(int64_t));
+
+        memcpy(apChildren, pInner->m_apChildren, (iSlot + 1) * sizeof(void*));
+        apChildren[iSlot + 1] = pNewChild;
+        memcpy(&apChildren[iSlot + 2], &pInner->m_apChildren[iSlot + 1], (BTREE_MAX_KEYS - iSlot) * sizeof(void*));
+
+        uint32_t      iMid        = (BTREE_MAX_KEYS + 1) / 2;
+        BTreeInner_t* pInnerRight = BTree_NewInner(pTree);
+
+        memcpy(pInner->m_aKeys,      aKeys,      iMid * sizeof(int64_t));
+        memcpy(pInner->m_apChildren, apChildren, (iMid + 1) * sizeof(void*));
+        pInner->m_nKeys = iMid;
+        BTree_PadKeys(pInner->m_aKeys, iMid);
+
+        pInnerRight->m_nKeys = BTREE_MAX_KEYS - iMid;
+        memcpy(pInnerRight->m_aKeys,      &aKeys[iMid + 1],      pInnerRight->m_nKeys * sizeof(int64_t));
+        memcpy(pInnerRight->m_apChildren, &apChildren[iMid + 1], (pInnerRight->m_nKeys + 1) * sizeof(void*));
+
+        iSeparator = aKeys[iMid];
+        pNewChild  = pInnerRight;
+    }
+
+
+    // Root got split, grow a level.
+    assertion(pTree->m_iHeight < BTREE_MAX_HEIGHT && "BTree too tall");
+
+    BTreeInner_t* pNewRoot = BTree_NewInner(pTree);
+    pNewRoot->m_aKeys[0]      = iSeparator;
+    pNewRoot->m_apChildren[0] = pTree->m_pRoot;
+    pNewRoot->m_apChildren[1] = pNewChild;
+    pNewRoot->m_nKeys         = 1;
+
+    pTree->m_pRoot = pNewRoot;
+    pTree->m_iHeight++;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t* BTree_Find(BTree_t* pTree, int64_t iKey)
+{
+    BTreeLeaf_t* pLeaf = BTree_FindLeaf(pTree, iKey);
+    if(pLeaf == nullptr)
+        return nullptr;
+
+    uint32_t iIndex = BTree_LeafIndex(pLeaf, iKey);
+    if(iIndex < pLeaf->m_nKeys && pLeaf->m_aKeys[iIndex] == iKey)
+        return &pLeaf->m_aValues[iIndex];
+
+    return nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool BTree_Erase(BTree_t* pTree, int64_t iKey)
+{
+    BTreeLeaf_t* pLeaf = BTree_FindLeaf(pTree, iKey);
+    if(pLeaf == nullptr)
+        return false;
+
+    uint32_t iIndex = BTree_LeafIndex(pLeaf, iKey);
+    if(iIndex >= pLeaf->m_nKeys || pLeaf->m_aKeys[iIndex] != iKey)
+        return false;
+
+
+    // Separators above stay valid bounds even if this was the smallest key of the leaf.
+    pLeaf->m_nKeys--;
+    memmove(&pLeaf->m_aKeys[iIndex],   &pLeaf->m_aKeys[iIndex + 1],   (pLeaf->m_nKeys - iIndex) * sizeof(int64_t));
+    memmove(&pLeaf->m_aValues[iIndex], &pLeaf->m_aValues[iIndex + 1], (pLeaf->m_nKeys - iIndex) * sizeof(uint64_t));
+    pLeaf->m_aKeys[pLeaf->m_nKeys] = BTREE_EMPTY_KEY;
+
+    pTree->m_nKeys--;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTree_BulkLoad(BTree_t* pTree, const int64_t* pKeys, const uint64_t* pValues)
+{
+    BTree_Clear(pTree);
+
+    uint32_t nKeys = Vector_Len(pKeys);
+    assertion((pValues == nullptr || Vector_Len(pValues) == nKeys) && "Key & value count mismatch");
+    if(nKeys == 0)
+        return;
+
+
+    // Leaves, filled left to right. They come out of the arena back to back.
+    void**   pLevel = NULL;   // ISTDLIB vector, nodes of level being built.
+    int64_t* pMins  = NULL;   // ISTDLIB vector, smallest key under each node in pLevel.
+
+    BTreeLeaf_t* pPrevLeaf = nullptr;
+    for(uint32_t iKey = 0; iKey < nKeys; iKey += BTREE_BULK_FILL)
+    {
+        BTreeLeaf_t* pLeaf  = BTree_NewLeaf(pTree);
+        uint32_t     nCount = nKeys - iKey < BTREE_BULK_FILL ? nKeys - iKey : BTREE_BULK_FILL;
+
+        for(uint32_t i = 0; i < nCount; i++)
+        {
+            assertion((iKey + i == 0 || pKeys[iKey + i - 1] < pKeys[iKey + i]) && "Keys must be strictly ascending");
+            assertion(pKeys[iKey + i] != BTREE_EMPTY_KEY && "INT64_MAX is reserved for empty key slots");
+
+            pLeaf->m_aKeys[i]   = pKeys[iKey + i];
+            pLeaf->m_aValues[i] = pValues == nullptr ? (uint64_t)(iKey + i) : pValues[iKey + i];
+        }
+        pLeaf->m_nKeys = nCount;
+
+        if(pPrevLeaf == nullptr)
+            pTree->m_pFirstLeaf = pLeaf;
+        else
+            pPrevLeaf->m_pNext = pLeaf;
+        pPrevLeaf = pLeaf;
+
+        void* pNode = pLeaf;
+        Vector_PushBack(pLevel, pNode);
+        Vector_PushBack(pMins,  pLeaf->m_aKeys[0]);
+    }
+
+    pTree->m_nKeys   = nKeys;
+    pTree->m_iHeight = 1;
+
+
+    // Inner levels on top, untill one node is left.
+    while(Vector_Len(pLevel) > 1)
+    {
+        void**   pNextLevel = NULL;
+        int64_t* pNextMins  = NULL;
+        uint32_t nNodes     = Vector_Len(pLevel);
+
+        for(uint32_t iNode = 0; iNode < nNodes; iNode += BTREE_BULK_FILL + 1)
+        {
+            BTreeInner_t* pInner  = BTree_NewInner(pTree);
+            uint32_t      nChilds = nNodes - iNode < BTREE_BULK_FILL + 1 ? nNodes - iNode : BTREE_BULK_FILL + 1;
+
+            for(uint32_t i = 0; i < nChilds; i++)
+            {
+                pInner->m_apChildren[i] = pLevel[iNode + i];
+                if(i > 0)
+                    pInner->m_aKeys[i - 1] = pMins[iNode + i];
+            }
+            pInner->m_nKeys = nChilds - 1;
+
+            void* pNode = pInner;
+            Vector_PushBack(pNextLevel, pNode);
+            Vector_PushBack(pNextMins,  pMins[iNode]);
+        }
+
+        Vector_Free(pLevel);
+        Vector_Free(pMins);
+        pLevel = pNextLevel;
+        pMins  = pNextMins;
+
+        pTree->m_iHeight++;
+        assertion(pTree->m_iHeight <= BTREE_MAX_HEIGHT && "BTree too tall");
+    }
+
+    pTree->m_pRoot = pLevel[0];
+
+    Vector_Free(pLevel);
+    Vector_Free(pMins);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTreeIterator_SkipEmpty(BTreeIterator_t* pIterator)
+{
+    // Lazy erase can leave leaves partially or fully empty.
+    while(pIterator->m_pLeaf != nullptr && pIterator->m_iIndex >= pIterator->m_pLeaf->m_nKeys)
+    {
+        pIterator->m_pLeaf  = pIterator->m_pLeaf->m_pNext;
+        pIterator->m_iIndex = 0;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static BTreeIterator_t BTree_Begin(BTree_t* pTree)
+{
+    BTreeIterator_t iterator = { pTree->m_pFirstLeaf, 0 };
+    BTreeIterator_SkipEmpty(&iterator);
+
+    return iterator;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static BTreeIterator_t BTree_LowerBound(BTree_t* pTree, int64_t iKey)
+{
+    BTreeIterator_t iterator = { BTree_FindLeaf(pTree, iKey), 0 };
+
+    if(iterator.m_pLeaf != nullptr)
+        iterator.m_iIndex = BTree_LeafIndex(iterator.m_pLeaf, iKey);
+
+    BTreeIterator_SkipEmpty(&iterator);
+    return iterator;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool BTreeIterator_Valid(BTreeIterator_t* pIterator)
+{
+    return pIterator->m_pLeaf != nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BTreeIterator_Next(BTreeIterator_t* pIterator)
+{
+    assertion(pIterator->m_pLeaf != nullptr && "Iterator is past the end");
+
+    pIterator->m_iIndex++;
+    BTreeIterator_SkipEmpty(pIterator);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static int64_t BTreeIterator_Key(BTreeIterator_t* pIterator)
+{
+    return pIterator->m_pLeaf->m_aKeys[pIterator->m_iIndex];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t* BTreeIterator_Value(BTreeIterator_t* pIterator)
+{
+    return &pIterator->m_pLeaf->m_aValues[pIterator->m_iIndex];
+}
+
+
+#endif
@@ -0,0 +1,455 @@
+//=========================================================================
+//                      ILIB C++ Layer
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Type-safe C++17 wrappers over ILIB_Vector & ILIB_ArenaAllocator.
+//           Same memory layout as the C side, so containers can be passed
+//           back & forth.
+//-------------------------------------------------------------------------
+#ifndef ILIB_CPP_HPP
+#define ILIB_CPP_HPP
+
+
+
+#include <new>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+#include "ILIB_ArenaAllocator.h"
+
+/*
+
+ilib::Vector<T> holds the same pointer a C vector does :
+    [ VectorHeader_t ][ Entry 0 ][ Entry 1 ][ Entry 2 ]...
+                        ^ Data()
+
+So Data() can be handed to any Vector_*() macro, and a vector built in C can be
+taken over with ilib::Vector<T>::Adopt().
+
+Elements are relocated with realloc() / memmove() when T is trivially relocatable, else
+they are move-constructed into a new block. Specialize ilib::IsTriviallyRelocatable<T> for
+types that survive a memcpy() but aren't trivially copyable, like std::unique_ptr. Never
+for types that point into themselves, libstdc++'s std::string does for short strings.
+
+Only touch vectors of non-trivially-relocatable types from C to read them. C macros memmove()
+& assign, and Vector_Free() won't call destructors.
+
+*/
+
+
+namespace ilib
+{
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+template<typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+template<typename T>
+class Vector
+{
+public:
+    static_assert(alignof(T) <= sizeof(VectorHeader_t), "Elements right after VectorHeader_t can't be aligned to more than its size.");
+
+    Vector() = default;
+    ~Vector() { Free(); }
+
+    Vector(const Vector& other)
+    {
+        Reserve(other.Len());
+        for(uint32_t iIndex = 0; iIndex < other.Len(); iIndex++)
+            EmplaceBack(other.m_pData[iIndex]);
+    }
+
+    Vector(Vector&& other) noexcept : m_pData(other.m_pData)
+    {
+        other.m_pData = nullptr;
+    }
+
+    Vector& operator=(const Vector& other)
+    {
+        if(this != &other)
+        {
+            Vector copy(other);
+            std::swap(m_pData, copy.m_pData);
+        }
+        return *this;
+    }
+
+    Vector& operator=(Vector&& other) noexcept
+    {
+        if(this != &other)
+        {
+            Free();
+            m_pData       = other.m_pData;
+            other.m_pData = nullptr;
+        }
+        return *this;
+    }
+
+
+    /* Take ownership of a vector created by the C macros. */
+    static Vector Adopt(T* pContainer)
+    {
+        if(pContainer != nullptr)
+            Vector_VerifyRequest((void**)&pContainer, sizeof(T), 0, false);
+
+        Vector vec;
+        vec.m_pData = pContainer;
+        return vec;
+    }
+
+    /* Give up ownership, returned pointer is a regular C vector. ( nullptr if empty & never allocated ) */
+    T* Release()
+    {
+        T* pData = m_pData;
+        m_pData  = nullptr;
+        return pData;
+    }
+
+
+    T*       Data()        { return m_pData; }
+    const T* Data()  const { return m_pData; }
+    uint32_t Len()   const { return Vector_Len(m_pData); }
+    uint32_t Capacity() const { return Vector_Capacity(m_pData); }
+    bool     Empty() const { return Len() == 0; }
+
+    T&       operator[](uint32_t iIndex)       { assertion(iIndex < Len() && "Out of bound"); return m_pData[iIndex]; }
+    const T& operator[](uint32_t iIndex) const { assertion(iIndex < Len() && "Out of bound"); return m_pData[iIndex]; }
+
+    T&       Front()       { return m_pData[0]; }
+    const T& Front() const { return m_pData[0]; }
+    T&       Back()        { return m_pData[Len() - 1]; }
+    const T& Back()  const { return m_pData[Len() - 1]; }
+
+    T*       begin()       { return m_pData; }
+    const T* begin() const { return m_pData; }
+    T*       end()         { return m_pData + Len(); }
+    const T* end()   const { return m_pData + Len(); }
+
+
+    /* Increase capacity to hold ICAPACITY elements. */
+    void Reserve(uint32_t iCapacity)
+    {
+        if(iCapacity > Capacity())
+            Reallocate(iCapacity);
+    }
+
+    /* Set element count to ISIZE. New elements are value-initialized, removed ones destroyed. */
+    void Resize(uint32_t iSize)
+    {
+        Reserve(iSize);
+
+        for(uint32_t iIndex = Len(); iIndex < iSize; iIndex++)
+            new (&m_pData[iIndex]) T();
+
+        DestroyRange(iSize, Len());
+
+        if(m_pData != nullptr)
+            Vector_GetHeader(m_pData)->m_iSize = iSize;
+    }
+
+    template<typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        uint32_t iSize = Len();
+
+        // ARGS may point into our own block ( v.PushBack(v[0]) ), build the element before growing frees it.
+        if(iSize == Capacity())
+        {
+            T temp(std::forward<Args>(args)...);
+            Grow(iSize + 1);
+
+            T* pElement = new (&m_pData[iSize]) T(std::move(temp));
+            Vector_GetHeader(m_pData)->m_iSize = iSize + 1;
+            return *pElement;
+        }
+
+        T* pElement = new (&m_pData[iSize]) T(std::forward<Args>(args)...);
+        Vector_GetHeader(m_pData)->m_iSize = iSize + 1;
+        return *pElement;
+    }
+
+    void PushBack(const T& data) { EmplaceBack(data); }
+    void PushBack(T&& data)      { EmplaceBack(std::move(data)); }
+
+    void PopBack()
+    {
+        assertion(Len() > 0 && "Empty vector");
+
+        uint32_t iLast = Len() - 1;
+        m_pData[iLast].~T();
+        Vector_GetHeader(m_pData)->m_iSize = iLast;
+    }
+
+    /* Insert DATA at IINDEX, shifting everything after it. IINDEX can be at most Len(). */
+    void Insert(uint32_t iIndex, T data)
+    {
+        uint32_t iSize = Len();
+        assertion(iIndex <= iSize && "Out of bound");
+
+        if(iIndex == iSize)
+        {
+            EmplaceBack(std::move(data));
+            return;
+        }
+
+        if(iSize == Capacity())
+            Grow(iSize + 1);
+
+        if constexpr(IsTriviallyRelocatable<T>::value == true)
+        {
+            memmove((void*)&m_pData[iIndex + 1], (void*)&m_pData[iIndex], (iSize - iIndex) * sizeof(T));
+            new (&m_pData[iIndex]) T(std::move(data));
+        }
+        else
+        {
+            new (&m_pData[iSize]) T(std::move(m_pData[iSize - 1]));
+            for(uint32_t i = iSize - 1; i > iIndex; i--)
+                m_pData[i] = std::move(m_pData[i - 1]);
+
+            m_pData[iIndex] = std::move(data);
+        }
+
+        Vector_GetHeader(m_pData)->m_iSize = iSize + 1;
+    }
+
+    /* Erase element at IINDEX, shifting everything after it. */
+    void Erase(uint32_t iIndex)
+    {
+        uint32_t iSize = Len();
+        assertion(iIndex < iSize && "Trying to erase out of bound entry");
+
+        if constexpr(IsTriviallyRelocatable<T>::value == true)
+        {
+            m_pData[iIndex].~T();
+            memmove((void*)&m_pData[iIndex], (void*)&m_pData[iIndex + 1], (iSize - iIndex - 1) * sizeof(T));
+        }
+        else
+        {
+            for(uint32_t i = iIndex; i + 1 < iSize; i++)
+                m_pData[i] = std::move(m_pData[i + 1]);
+
+            m_pData[iSize - 1].~T();
+        }
+
+        Vector_GetHeader(m_pData)->m_iSize = iSize - 1;
+    }
+
+    /* Destroy all elements, keep capacity. */
+    void Clear()
+    {
+        DestroyRange(0, Len());
+        Vector_Clear(m_pData);
+    }
+
+    /* Destroy all elements & free memory. */
+    void Free()
+    {
+        if(m_pData == nullptr)
+            return;
+
+        DestroyRange(0, Len());
+        Vector_Free(m_pData);
+    }
+
+
+private:
+    void DestroyRange(uint32_t iBegin, uint32_t iEnd)
+    {
+        if constexpr(std::is_trivially_destructible_v<T> == false)
+        {
+            for(uint32_t iIndex = iBegin; iIndex < iEnd; iIndex++)
+                m_pData[iIndex].~T();
+        }
+    }
+
+    /* Grow by STD_VECTOR_GROWTH untill we can hold IMINCAPACITY elements. */
+    void Grow(uint32_t iMinCapacity)
+    {
+        uint32_t iCapacity = Capacity() == 0 ? STD_VECTOR_CAPACITY : Capacity();
+        while(iCapacity < iMinCapacity)
+            iCapacity *= (uint32_t)STD_VECTOR_GROWTH;
+
+        Reallocate(iCapacity);
+    }
+
+    void Reallocate(uint32_t iNewCapacity)
+    {
+        // memcpy is fine, let the C side realloc.
+        if constexpr(IsTriviallyRelocatable<T>::value == true)
+        {
+            Vector_AssertInit ((void**)&m_pData, sizeof(T));
+            Vector_GrowToIndex((void**)&m_pData, sizeof(T), (int)iNewCapacity - 1);
+        }
+        // Else move-construct everything into a new block.
+        else
+        {
+            uint32_t        iSize      = Len();
+            size_t          iNewSize   = sizeof(VectorHeader_t) + sizeof(T) * iNewCapacity;
+            VectorHeader_t* pNewHeader = (VectorHeader_t*)malloc(iNewSize);
+            assertion(pNewHeader != nullptr && "You made malloc() fail. Consider touching some grass now.");
+
+            pNewHeader->m_iSignature   = STD_VECTOR_SIGNATURE;
+            pNewHeader->m_iCapacity    = iNewCapacity;
+            pNewHeader->m_iSize        = iSize;
+            pNewHeader->m_iElementSize = sizeof(T);
+
+            T* pNewData = (T*)&pNewHeader[1];
+            for(uint32_t iIndex = 0; iIndex < iSize; iIndex++)
+            {
+                new (&pNewData[iIndex]) T(std::move_if_noexcept(m_pData[iIndex]));
+                m_pData[iIndex].~T();
+            }
+
+            if(m_pData != nullptr)
+                free(Vector_GetHeader(m_pData));
+
+            m_pData = pNewData;
+        }
+    }
+
+
+    T* m_pData = nullptr;  // Same pointer a C vector holds, header is right before it.
+};
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+class Arena
+{
+public:
+    explicit Arena(int nArenas = 1, size_t iArenaSize = STD_ARENA_SIZE)
+    {
+        bool bInitialized = ArenaAllocator_Initialize(&m_arenaAlloc, nArenas, iArenaSize);
+        assertion(bInitialized == true && "Failed to initialize ArenaAllocator");
+    }
+
+    ~Arena()
+    {
+        if(m_arenaAlloc.m_pArenas != nullptr)
+            ArenaAllocator_Free(&m_arenaAlloc);
+    }
+
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&& other) noexcept : m_arenaAlloc(other.m_arenaAlloc)
+    {
+        other.m_arenaAlloc = ArenaAllocator_t{};
+    }
+
+    Arena& operator=(Arena&& other) noexcept
+    {
+        if(this != &other)
+        {
+            if(m_arenaAlloc.m_pArenas != nullptr)
+                ArenaAllocator_Free(&m_arenaAlloc);
+
+            m_arenaAlloc       = other.m_arenaAlloc;
+            other.m_arenaAlloc = ArenaAllocator_t{};
+        }
+        return *this;
+    }
+
+
+    void*  Allocate(size_t nBytes) { return ArenaAllocator_Allocate(&m_arenaAlloc, nBytes); }
+    void   Clear()                 { ArenaAllocator_Clear(&m_arenaAlloc); }
+    size_t Size()                  { return ArenaAllocator_Size(&m_arenaAlloc); }
+    size_t Capacity()              { return ArenaAllocator_Capacity(&m_arenaAlloc); }
+
+    /* Underlying C allocator. */
+    ArenaAllocator_t* Get() { return &m_arenaAlloc; }
+
+
+    /* Construct a T in the arena. Arenas never run destructors, so T must not need one. */
+    template<typename T, typename... Args>
+    T* New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,  "Arena memory is dropped without calling destructors.");
+        static_assert(alignof(T) <= STD_ARENA_MEMORY_ALIGNMENT, "Arena can't align this type.");
+
+        void* pMemory = Allocate(sizeof(T));
+        return pMemory == nullptr ? nullptr : new (pMemory) T(std::forward<Args>(args)...);
+    }
+
+    /* Value-initialized array of NCOUNT T's in the arena. */
+    template<typename T>
+    T* NewArray(size_t nCount)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,  "Arena memory is dropped without calling destructors.");
+        static_assert(alignof(T) <= STD_ARENA_MEMORY_ALIGNMENT, "Arena can't align this type.");
+
+        T* pArray = (T*)Allocate(sizeof(T) * nCount);
+        if(pArray == nullptr)
+            return nullptr;
+
+        for(size_t iIndex = 0; iIndex < nCount; iIndex++)
+            new (&pArray[iIndex]) T();
+
+        return pArray;
+    }
+
+
+private:
+    ArenaAllocator_t m_arenaAlloc{};
+};
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+/* Lets std containers allocate from an ArenaAllocator_t. deallocate() is a no-op,
+ * memory comes back when the arena is cleared or freed. */
+template<typename T>
+class ArenaStlAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaStlAllocator(ArenaAllocator_t* pArenaAlloc) noexcept : m_pArenaAlloc(pArenaAlloc) {}
+    ArenaStlAllocator(Arena& arena)                  noexcept : m_pArenaAlloc(arena.Get()) {}
+
+    template<typename U>
+    ArenaStlAllocator(const ArenaStlAllocator<U>& other) noexcept : m_pArenaAlloc(other.m_pArenaAlloc) {}
+
+
+    T* allocate(size_t nCount)
+    {
+        static_assert(alignof(T) <= STD_ARENA_MEMORY_ALIGNMENT, "Arena can't align this type.");
+
+        if(nCount > SIZE_MAX / sizeof(T))
+            throw std::bad_array_new_length();
+
+        void* pMemory = ArenaAllocator_Allocate(m_pArenaAlloc, nCount * sizeof(T));
+        if(pMemory == nullptr)
+            throw std::bad_alloc();
+
+        return (T*)pMemory;
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+
+    template<typename U>
+    bool operator==(const ArenaStlAllocator<U>& other) const noexcept { return m_pArenaAlloc == other.m_pArenaAlloc; }
+
+    template<typename U>
+    bool operator!=(const ArenaStlAllocator<U>& other) const noexcept { return m_pArenaAlloc != other.m_pArenaAlloc; }
+
+
+    ArenaAllocator_t* m_pArenaAlloc;
+};
+
+} // namespace ilib
+
+
+#endif
@@ -0,0 +1,298 @@
+//=========================================================================
+//                      ILIB Frame Allocator
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Ring of ArenaAllocators, one per frame. Memory allocated in
+//           frame N stays valid until frame N + generation count.
+//-------------------------------------------------------------------------
+#ifndef ILIB_FRAME_ALLOCATOR_H
+#define ILIB_FRAME_ALLOCATOR_H
+
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+#include "ILIB_ArenaAllocator.h"
+
+
+#ifndef __cplusplus
+#define nullptr                    ((void*)0)
+#endif
+#define STD_FRAME_GENERATIONS      (2)      // Double buffered by default.
+#define STD_FRAME_POISON_BYTE      (0xDD)   // Retired generations are filled with this when poisoning is on.
+
+
+/* Poison retired generations before they get reused, so reads of stale frame data show up as 0xDDDDDDDD.
+ * Debugging aid, off by default. Costs a memset of everything the oldest frame used, on every FrameAllocator_BeginFrame(). */
+#ifndef ENABLE_FRAME_POISONING
+#define ENABLE_FRAME_POISONING 0
+#endif
+
+/*
+
+Frame Allocator Structure :
+    [ Generation 0 ][ Generation 1 ]...[ Generation K - 1 ]
+          ^ frame 0, K, 2K ...
+
+Each generation is an ArenaAllocator_t with one arena of frame budget size. BeginFrame()
+moves to the next generation and clears it, that is the generation that was used K frames ago.
+As long as frames stay within budget, every generation keeps exactly one arena, so clearing
+is O(1) and allocating never calls malloc.
+
+Going over budget spills into new, geometrically bigger arenas ( which are kept & reused from then on ) and gets reported.
+That includes allocations bigger than the budget, the new arena is made at least that big.
+
+*/
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+/* Called the first time a frame goes over budget. */
+typedef void (*FrameOverflowFn_t)(uint64_t iFrame, size_t iFrameBytes, size_t iFrameBudget, void* pContext);
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct FrameAllocator_t
+{
+    ArenaAllocator_t* m_pGenerations;     // ISTDLIB vector of ArenaAllocator_t. Never grows after init.
+    uint64_t          m_iFrame;           // Index of current frame, starts from 0.
+    size_t            m_iFrameBudget;     // Bytes we expect a frame to allocate at most.
+
+    size_t            m_iFrameBytes;      // Bytes used in current frame, each allocation rounded up to STD_ARENA_MEMORY_ALIGNMENT.
+    size_t            m_iPeakFrameBytes;  // Biggest m_iFrameBytes seen so far.
+    uint64_t          m_nOverflowFrames;  // Number of frames that went over budget.
+    bool              m_bOverflowed;      // Current frame went over budget already.
+
+    FrameOverflowFn_t m_pOnOverflow;      // nullptr prints a message instead.
+    void*             m_pOverflowContext;
+
+} FrameAllocator_t;
+
+
+/* Initialize NGENERATIONS arena allocators, each with one arena of IFRAMEBUDGET bytes.
+ * NGENERATIONS <= 0 uses STD_FRAME_GENERATIONS. Memory of a frame is valid for NGENERATIONS - 1 more frames. */
+static bool FrameAllocator_Initialize(FrameAllocator_t* pFrameAlloc, int nGenerations, size_t iFrameBudget);
+
+/* Free all generations and uninitialize this FrameAllocator. */
+static void FrameAllocator_Free(FrameAllocator_t* pFrameAlloc);
+
+/* Set function to call when a frame goes over budget. PFUNCTION = nullptr prints instead. */
+static void FrameAllocator_SetOverflowCallback(FrameAllocator_t* pFrameAlloc, FrameOverflowFn_t pFunction, void* pContext);
+
+/* Move on to next frame. Recycles ( & poisons if enabled ) the oldest generation. */
+static void FrameAllocator_BeginFrame(FrameAllocator_t* pFrameAlloc);
+
+/* Allocate NBYTES bytes that stay valid for this frame & next NGENERATIONS - 1 frames. */
+static void* FrameAllocator_Allocate(FrameAllocator_t* pFrameAlloc, size_t nBytes);
+
+/* ArenaAllocator_t of the frame IFRAMESAGO frames before current one. 0 is current frame. */
+static ArenaAllocator_t* FrameAllocator_Generation(FrameAllocator_t* pFrameAlloc, int iFramesAgo);
+
+/* Index of current frame. */
+static uint64_t FrameAllocator_FrameIndex(FrameAllocator_t* pFrameAlloc);
+
+/* Bytes used in current frame. Every allocation counts rounded up to STD_ARENA_MEMORY_ALIGNMENT. */
+static size_t FrameAllocator_FrameSize(FrameAllocator_t* pFrameAlloc);
+
+/* Most bytes any frame has used so far. Handy to pick a budget. */
+static size_t FrameAllocator_PeakFrameSize(FrameAllocator_t* pFrameAlloc);
+
+/* Number of frames that went over budget. */
+static uint64_t FrameAllocator_OverflowCount(FrameAllocator_t* pFrameAlloc);
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool FrameAllocator_Initialize(FrameAllocator_t* pFrameAlloc, int nGenerations, size_t iFrameBudget)
+{
+    if(nGenerations <= 0)
+        nGenerations = STD_FRAME_GENERATIONS;
+
+    if(iFrameBudget == 0)
+        iFrameBudget = STD_ARENA_SIZE;
+
+
+    pFrameAlloc->m_pGenerations     = NULL;
+    pFrameAlloc->m_iFrame           = 0;
+    pFrameAlloc->m_iFrameBudget     = iFrameBudget;
+    pFrameAlloc->m_iFrameBytes      = 0;
+    pFrameAlloc->m_iPeakFrameBytes  = 0;
+    pFrameAlloc->m_nOverflowFrames  = 0;
+    pFrameAlloc->m_bOverflowed      = false;
+    pFrameAlloc->m_pOnOverflow      = nullptr;
+    pFrameAlloc->m_pOverflowContext = nullptr;
+
+
+    // Generations are never pushed back after this, so pointers to them stay valid.
+    Vector_Reserve(pFrameAlloc->m_pGenerations, nGenerations);
+    for(int iGenIndex = 0; iGenIndex < nGenerations; iGenIndex++)
+    {
+        ArenaAllocator_t arenaAlloc;
+        if(ArenaAllocator_Initialize(&arenaAlloc, 1, iFrameBudget) == false)
+        {
+            FrameAllocator_Free(pFrameAlloc);
+            return false;
+        }
+
+        Vector_PushBack(pFrameAlloc->m_pGenerations, arenaAlloc);
+    }
+
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void FrameAllocator_Free(FrameAllocator_t* pFrameAlloc)
+{
+    for(int iGenIndex = 0; iGenIndex < Vector_Len(pFrameAlloc->m_pGenerations); iGenIndex++)
+    {
+        ArenaAllocator_Free(&pFrameAlloc->m_pGenerations[iGenIndex]);
+    }
+
+    Vector_Free(pFrameAlloc->m_pGenerations);
+
+    pFrameAlloc->m_iFrame      = 0;
+    pFrameAlloc->m_iFrameBytes = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void FrameAllocator_SetOverflowCallback(FrameAllocator_t* pFrameAlloc, FrameOverflowFn_t pFunction, void* pContext)
+{
+    pFrameAlloc->m_pOnOverflow      = pFunction;
+    pFrameAlloc->m_pOverflowContext = pContext;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void FrameAllocator_BeginFrame(FrameAllocator_t* pFrameAlloc)
+{
+    assertion(pFrameAlloc->m_pGenerations != nullptr && "FrameAllocator is uninitialized");
+
+    if(pFrameAlloc->m_iFrameBytes > pFrameAlloc->m_iPeakFrameBytes)
+        pFrameAlloc->m_iPeakFrameBytes = pFrameAlloc->m_iFrameBytes;
+
+    pFrameAlloc->m_iFrame++;
+    pFrameAlloc->m_iFrameBytes = 0;
+    pFrameAlloc->m_bOverflowed = false;
+
+
+    // Generation we are moving into was last used K frames ago. Nobody should be holding its memory anymore.
+    ArenaAllocator_t* pOldest = FrameAllocator_Generation(pFrameAlloc, 0);
+
+#if (ENABLE_FRAME_POISONING == 1)
+    for(int iArenaIndex = 0; iArenaIndex < Vector_Len(pOldest->m_pArenas); iArenaIndex++)
+    {
+        Arena_t* pArena = &pOldest->m_pArenas[iArenaIndex];
+        memset(pArena->m_pMemory, STD_FRAME_POISON_BYTE, Arena_GetSize(pArena));
+    }
+#endif
+
+    ArenaAllocator_Clear(pOldest);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* FrameAllocator_Allocate(FrameAllocator_t* pFrameAlloc, size_t nBytes)
+{
+    assertion(pFrameAlloc->m_pGenerations != nullptr && "FrameAllocator is uninitialized");
+
+    // Arena pads every allocation to alignment, count what it really consumes.
+    size_t iAlignment = STD_ARENA_MEMORY_ALIGNMENT;
+    if(iAlignment > 0)
+        pFrameAlloc->m_iFrameBytes += ((nBytes + (iAlignment - 1)) / iAlignment) * iAlignment;
+    else
+        pFrameAlloc->m_iFrameBytes += nBytes;
+
+
+    // Spilling into a new arena means we went over budget, even if the byte count says otherwise.
+    ArenaAllocator_t* pGeneration = FrameAllocator_Generation(pFrameAlloc, 0);
+    size_t            nOldArenas  = ArenaAllocator_ArenaCount(pGeneration);
+    void*             pMemory     = ArenaAllocator_Allocate(pGeneration, nBytes);
+    bool              bSpilled    = ArenaAllocator_ArenaCount(pGeneration) > nOldArenas;
+
+
+    // Report only the first allocation that goes over budget, not every one after it.
+    if(pFrameAlloc->m_bOverflowed == false && (bSpilled == true || pFrameAlloc->m_iFrameBytes > pFrameAlloc->m_iFrameBudget))
+    {
+        pFrameAlloc->m_bOverflowed = true;
+        pFrameAlloc->m_nOverflowFrames++;
+
+        if(pFrameAlloc->m_pOnOverflow != nullptr)
+        {
+            pFrameAlloc->m_pOnOverflow(pFrameAlloc->m_iFrame, pFrameAlloc->m_iFrameBytes, pFrameAlloc->m_iFrameBudget, pFrameAlloc->m_pOverflowContext);
+        }
+        else
+        {
+            printf("FrameAllocator over budget!\n");
+            printf("Frame      : %llu\n", (unsigned long long)pFrameAlloc->m_iFrame);
+            printf("Used       : %zu bytes\n", pFrameAlloc->m_iFrameBytes);
+            printf("Budget     : %zu bytes\n", pFrameAlloc->m_iFrameBudget);
+        }
+    }
+
+
+    return pMemory;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static ArenaAllocator_t* FrameAllocator_Generation(FrameAllocator_t* pFrameAlloc, int iFramesAgo)
+{
+    uint64_t nGenerations = Vector_Len(pFrameAlloc->m_pGenerations);
+
+    assertion(iFramesAgo >= 0 && iFramesAgo < nGenerations && "Frame is already recycled");
+    assertion(iFramesAgo <= pFrameAlloc->m_iFrame           && "Frame doesn't exist yet");
+
+    return &pFrameAlloc->m_pGenerations[(pFrameAlloc->m_iFrame - (uint64_t)iFramesAgo) % nGenerations];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t FrameAllocator_FrameIndex(FrameAllocator_t* pFrameAlloc)
+{
+    return pFrameAlloc->m_iFrame;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static size_t FrameAllocator_FrameSize(FrameAllocator_t* pFrameAlloc)
+{
+    return pFrameAlloc->m_iFrameBytes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static size_t FrameAllocator_PeakFrameSize(FrameAllocator_t* pFrameAlloc)
+{
+    return pFrameAlloc->m_iFrameBytes > pFrameAlloc->m_iPeakFrameBytes ? pFrameAlloc->m_iFrameBytes : pFrameAlloc->m_iPeakFrameBytes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t FrameAllocator_OverflowCount(FrameAllocator_t* pFrameAlloc)
+{
+    return pFrameAlloc->m_nOverflowFrames;
+}
+
+
+#endif
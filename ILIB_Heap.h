@@ -0,0 +1,662 @@
+//=========================================================================
+//                      ILIB Heap
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : d-ary heap / priority queue in C, stored in ILIB vectors.
+//-------------------------------------------------------------------------
+#ifndef ILIB_HEAP_H
+#define ILIB_HEAP_H
+
+
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+
+
+#ifndef __cplusplus
+#define nullptr               ((void*)0)
+#endif
+#define STD_HEAP_ARITY        (4)           // 4 children of 8 byte keys fill half a cache line.
+#define HEAP_KEY_ARITY        (4)           // Arity of KeyHeap_*(), compile time so index math turns into shifts.
+#define HEAP_INVALID_HANDLE   (0)           // Never handed out, generations start at 1.
+#define HEAP_INVALID_POSITION (0xFFFFFFFF)
+#define HEAP_SLOT_BITS        (32)          // Handle is [ generation : 32 ][ slot : 32 ].
+
+/*
+
+Heap Structure :
+    [ Entry 0 ][ Entry 1 ]...[ Entry N - 1 ][ Scratch ]
+    children of entry i are at i * Arity + 1 ... i * Arity + Arity
+
+Entry 0 is always the one that compares smallest. Capacity is kept at least one
+more than size, that extra slot is used as scratch while sifting.
+
+Handles are a slot index & a generation, same as ILIB_SlotMap.h. A slot's generation is bumped
+whenever its entry leaves the heap, so a handle kept after pop / erase never matches the entry
+that reuses its slot.
+
+Two flavours :
+    Heap_*()    : any element size, comparator, runtime arity, optional handles for Heap_Update() / Heap_Erase().
+    KeyHeap_*() : plain ILIB vector of int64_t keys, no callbacks. Use it when priority is all you need.
+
+*/
+
+
+/* Typed pointer to top entry, or nullptr if empty. Verifies sizeof(TYPE). */
+#define Heap_TopAs(pHeap, Type) ((Type*)Heap_TopVerified((pHeap), sizeof(Type)))
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+/* < 0 if PLEFT should come out before PRIGHT. qsort() style comparators give a min-heap. */
+typedef int (*HeapCompareFn_t)(const void* pLeft, const void* pRight);
+
+typedef uint64_t HeapHandle_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct Heap_t
+{
+    void*           m_pData;         // ISTDLIB vector, heap ordered entries.
+    uint32_t*       m_pSlots;        // ISTDLIB vector, handle slot of each entry. Only if m_bTrackHandles.
+    uint32_t*       m_pPositions;    // ISTDLIB vector, entry index of each slot. HEAP_INVALID_POSITION once popped.
+    uint32_t*       m_pGenerations;  // ISTDLIB vector, generation of each slot. Bumped when its entry leaves.
+    uint32_t*       m_pFreeSlots;    // ISTDLIB vector, slots ready for reuse.
+
+    size_t          m_iElementSize;
+    uint32_t        m_iArity;
+    HeapCompareFn_t m_pCompare;
+    bool            m_bTrackHandles;
+
+} Heap_t;
+
+
+/* Initialize empty heap. IARITY < 2 uses STD_HEAP_ARITY. Handles cost two extra writes per moved entry. */
+static void Heap_Initialize(Heap_t* pHeap, size_t iElementSize, uint32_t iArity, HeapCompareFn_t pCompare, bool bTrackHandles);
+
+/* Take ownership of ILIB vector PVECTOR & heapify it in O(n). Entry i gets handle Heap_MakeHandle(i, 1). */
+static void Heap_InitializeFrom(Heap_t* pHeap, void* pVector, uint32_t iArity, HeapCompareFn_t pCompare, bool bTrackHandles);
+
+/* Free all memory and uninitialize this Heap. */
+static void Heap_Free(Heap_t* pHeap);
+
+/* Number of entries. */
+static uint32_t Heap_Len(Heap_t* pHeap);
+
+/* Remove all entries. Handles go stale. O(n) when tracking handles. */
+static void Heap_Clear(Heap_t* pHeap);
+
+/* Pointer to top entry, or nullptr if empty. */
+static void* Heap_Top(Heap_t* pHeap);
+
+/* Copy PVALUE in. Returns its handle, HEAP_INVALID_HANDLE if not tracking handles. O(log n). */
+static HeapHandle_t Heap_Push(Heap_t* pHeap, const void* pValue);
+
+/* Remove top entry, copying it to POUT if not nullptr. Returns false if empty. O(arity * log n). */
+static bool Heap_Pop(Heap_t* pHeap, void* pOut);
+
+/* Pop up to NMAX entries in order into POUT. Returns number popped. */
+static uint32_t Heap_PopMany(Heap_t* pHeap, void* pOut, uint32_t nMax);
+
+/* Is HHANDLE still in the heap ? */
+static bool Heap_Contains(Heap_t* pHeap, HeapHandle_t hHandle);
+
+/* Pointer to entry of HHANDLE. Don't change its priority in place, pass new value to Heap_Update(). */
+static void* Heap_Get(Heap_t* pHeap, HeapHandle_t hHandle);
+
+/* Replace entry of HHANDLE with PVALUE & restore order. Works for both decrease & increase key. */
+static void Heap_Update(Heap_t* pHeap, HeapHandle_t hHandle, const void* pValue);
+
+/* Remove entry of HHANDLE from anywhere in the heap. */
+static void Heap_Erase(Heap_t* pHeap, HeapHandle_t hHandle);
+
+/* Same as Heap_Top(), asserts IELEMENTSIZE matches. Used by Heap_TopAs(). */
+static void* Heap_TopVerified(Heap_t* pHeap, size_t iElementSize);
+
+/* Handle for slot ISLOT at generation IGENERATION. */
+static HeapHandle_t Heap_MakeHandle(uint32_t iSlot, uint32_t iGeneration);
+
+
+/* Push IKEY onto ILIB vector *PPHEAP. ( nullptr is a valid empty heap ) */
+static void KeyHeap_Push(int64_t** ppHeap, int64_t iKey);
+
+/* Remove & return smallest key. Heap must not be empty. */
+static int64_t KeyHeap_Pop(int64_t* pHeap);
+
+/* Smallest key. Heap must not be empty. */
+static int64_t KeyHeap_Top(int64_t* pHeap);
+
+/* Pop up to NMAX smallest keys in order into POUT. Returns number popped. */
+static uint32_t KeyHeap_PopMany(int64_t* pHeap, int64_t* pOut, uint32_t nMax);
+
+/* Reorder any ILIB vector of keys into a heap in O(n). */
+static void KeyHeap_Heapify(int64_t* pHeap);
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static HeapHandle_t Heap_MakeHandle(uint32_t iSlot, uint32_t iGeneration)
+{
+    return ((HeapHandle_t)iGeneration << HEAP_SLOT_BITS) | (HeapHandle_t)iSlot;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t Heap_NextGeneration(uint32_t iGeneration)
+{
+    // Generation 0 is never used, that is what keeps HEAP_INVALID_HANDLE invalid.
+    iGeneration++;
+    return iGeneration == 0 ? 1 : iGeneration;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline void* Heap_At(Heap_t* pHeap, uint32_t iIndex)
+{
+    return (uint8_t*)pHeap->m_pData + pHeap->m_iElementSize * iIndex;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline void Heap_Place(Heap_t* pHeap, uint32_t iIndex, const void* pValue, uint32_t iSlot)
+{
+    void* pDest = Heap_At(pHeap, iIndex);
+    if(pDest != pValue)
+        memcpy(pDest, pValue, pHeap->m_iElementSize);
+
+    if(pHeap->m_bTrackHandles == true)
+    {
+        pHeap->m_pSlots[iIndex]    = iSlot;
+        pHeap->m_pPositions[iSlot] = iIndex;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline uint32_t Heap_SlotAt(Heap_t* pHeap, uint32_t iIndex)
+{
+    return pHeap->m_bTrackHandles == true ? pHeap->m_pSlots[iIndex] : HEAP_INVALID_POSITION;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline void Heap_ReleaseSlot(Heap_t* pHeap, uint32_t iSlot)
+{
+    // Entry left the heap, every handle to it goes stale.
+    pHeap->m_pPositions[iSlot]   = HEAP_INVALID_POSITION;
+    pHeap->m_pGenerations[iSlot] = Heap_NextGeneration(pHeap->m_pGenerations[iSlot]);
+    Vector_PushBack(pHeap->m_pFreeSlots, iSlot);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_SiftUp(Heap_t* pHeap, uint32_t iHole, const void* pValue, uint32_t iSlot)
+{
+    // Move parents down into the hole instead of swapping, PVALUE is written once at the end.
+    while(iHole > 0)
+    {
+        uint32_t iParent = (iHole - 1) / pHeap->m_iArity;
+        if(pHeap->m_pCompare(pValue, Heap_At(pHeap, iParent)) >= 0)
+            break;
+
+        Heap_Place(pHeap, iHole, Heap_At(pHeap, iParent), Heap_SlotAt(pHeap, iParent));
+        iHole = iParent;
+    }
+
+    Heap_Place(pHeap, iHole, pValue, iSlot);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_SiftDown(Heap_t* pHeap, uint32_t iHole, const void* pValue, uint32_t iSlot, uint32_t nCount)
+{
+    while(true)
+    {
+        uint32_t iFirstChild = iHole * pHeap->m_iArity + 1;
+        if(iFirstChild >= nCount)
+            break;
+
+        uint32_t iLastChild = iFirstChild + pHeap->m_iArity;
+        if(iLastChild > nCount)
+            iLastChild = nCount;
+
+        uint32_t iBest = iFirstChild;
+        for(uint32_t iChild = iFirstChild + 1; iChild < iLastChild; iChild++)
+        {
+            if(pHeap->m_pCompare(Heap_At(pHeap, iChild), Heap_At(pHeap, iBest)) < 0)
+                iBest = iChild;
+        }
+
+        if(pHeap->m_pCompare(Heap_At(pHeap, iBest), pValue) >= 0)
+            break;
+
+        Heap_Place(pHeap, iHole, Heap_At(pHeap, iBest), Heap_SlotAt(pHeap, iBest));
+        iHole = iBest;
+    }
+
+    Heap_Place(pHeap, iHole, pValue, iSlot);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_SetLen(Heap_t* pHeap, uint32_t nCount)
+{
+    // +1 for scratch slot.
+    Vector_AssertInit    (&pHeap->m_pData, pHeap->m_iElementSize);
+    Vector_MayGrowToIndex(&pHeap->m_pData, pHeap->m_iElementSize, (int)nCount);
+    Vector_GetHeader(pHeap->m_pData)->m_iSize = nCount;
+
+    if(pHeap->m_bTrackHandles == true)
+    {
+        Vector_AssertInit    ((void**)&pHeap->m_pSlots, sizeof(uint32_t));
+        Vector_MayGrowToIndex((void**)&pHeap->m_pSlots, sizeof(uint32_t), (int)nCount);
+        Vector_GetHeader(pHeap->m_pSlots)->m_iSize = nCount;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_Initialize(Heap_t* pHeap, size_t iElementSize, uint32_t iArity, HeapCompareFn_t pCompare, bool bTrackHandles)
+{
+    assertion(iElementSize > 0   && "Heap with 0 sized elements");
+    assertion(pCompare != nullptr && "Heap needs a comparator");
+
+    pHeap->m_pData         = NULL;
+    pHeap->m_pSlots        = NULL;
+    pHeap->m_pPositions    = NULL;
+    pHeap->m_pGenerations  = NULL;
+    pHeap->m_pFreeSlots    = NULL;
+    pHeap->m_iElementSize  = iElementSize;
+    pHeap->m_iArity        = iArity < 2 ? STD_HEAP_ARITY : iArity;
+    pHeap->m_pCompare      = pCompare;
+    pHeap->m_bTrackHandles = bTrackHandles;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_InitializeFrom(Heap_t* pHeap, void* pVector, uint32_t iArity, HeapCompareFn_t pCompare, bool bTrackHandles)
+{
+    assertion(pVector != nullptr && "Uninitialized container");
+
+    size_t iElementSize = Vector_GetHeader(pVector)->m_iElementSize;
+    Vector_VerifyRequest(&pVector, iElementSize, 0, false);
+
+    Heap_Initialize(pHeap, iElementSize, iArity, pCompare, bTrackHandles);
+    pHeap->m_pData = pVector;
+
+    uint32_t nCount = Vector_Len(pVector);
+    Heap_SetLen(pHeap, nCount);
+
+    if(bTrackHandles == true)
+    {
+        Vector_Resize(pHeap->m_pPositions,   nCount);
+        Vector_Resize(pHeap->m_pGenerations, nCount);
+        for(uint32_t iIndex = 0; iIndex < nCount; iIndex++)
+        {
+            pHeap->m_pSlots[iIndex]       = iIndex;
+            pHeap->m_pPositions[iIndex]   = iIndex;
+            pHeap->m_pGenerations[iIndex] = 1;
+        }
+    }
+
+    if(nCount < 2)
+        return;
+
+
+    // Floyd's heapify, sift down every parent starting from the last one.
+    void* pScratch = Heap_At(pHeap, nCount);
+    for(uint32_t iIndex = (nCount - 2) / pHeap->m_iArity + 1; iIndex > 0; iIndex--)
+    {
+        memcpy(pScratch, Heap_At(pHeap, iIndex - 1), iElementSize);
+        Heap_SiftDown(pHeap, iIndex - 1, pScratch, Heap_SlotAt(pHeap, iIndex - 1), nCount);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_Free(Heap_t* pHeap)
+{
+    // Untyped vector, can't use the macro.
+    if(pHeap->m_pData != nullptr)
+    {
+        Vector_VerifyRequest(&pHeap->m_pData, pHeap->m_iElementSize, 0, false);
+        free(Vector_GetHeader(pHeap->m_pData));
+        pHeap->m_pData = NULL;
+    }
+
+    Vector_Free(pHeap->m_pSlots);
+    Vector_Free(pHeap->m_pPositions);
+    Vector_Free(pHeap->m_pGenerations);
+    Vector_Free(pHeap->m_pFreeSlots);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t Heap_Len(Heap_t* pHeap)
+{
+    return Vector_Len(pHeap->m_pData);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_Clear(Heap_t* pHeap)
+{
+    // Slots stay around with bumped generations, so old handles can't match anything pushed later.
+    if(pHeap->m_bTrackHandles == true)
+    {
+        for(uint32_t iIndex = 0; iIndex < Heap_Len(pHeap); iIndex++)
+            Heap_ReleaseSlot(pHeap, pHeap->m_pSlots[iIndex]);
+
+        Vector_Clear(pHeap->m_pSlots);
+    }
+
+    if(pHeap->m_pData != nullptr)
+        Vector_GetHeader(pHeap->m_pData)->m_iSize = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* Heap_Top(Heap_t* pHeap)
+{
+    return Heap_Len(pHeap) == 0 ? nullptr : pHeap->m_pData;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static HeapHandle_t Heap_Push(Heap_t* pHeap, const void* pValue)
+{
+    uint32_t     nCount  = Heap_Len(pHeap);
+    uint32_t     iSlot   = HEAP_INVALID_POSITION;
+    HeapHandle_t hHandle = HEAP_INVALID_HANDLE;
+
+    if(pHeap->m_bTrackHandles == true)
+    {
+        if(Vector_Empty(pHeap->m_pFreeSlots) == false)
+        {
+            iSlot = *Vector_Back(pHeap->m_pFreeSlots);
+            Vector_PopBack(pHeap->m_pFreeSlots);
+        }
+        else
+        {
+            iSlot = Vector_Len(pHeap->m_pPositions);
+            Vector_PushBack(pHeap->m_pPositions,   (uint32_t)HEAP_INVALID_POSITION);
+            Vector_PushBack(pHeap->m_pGenerations, (uint32_t)1);
+        }
+
+        hHandle = Heap_MakeHandle(iSlot, pHeap->m_pGenerations[iSlot]);
+    }
+
+
+    // PVALUE may point into our own entries ( Heap_Push(h, Heap_Top(h)) ). Growing can move it
+    // & sifting overwrites it, so find it again after growing & sift from the scratch slot.
+    uintptr_t iData    = (uintptr_t)pHeap->m_pData;
+    uintptr_t iValue   = (uintptr_t)pValue;
+    bool      bAliased = pHeap->m_pData != nullptr && iValue >= iData && iValue < iData + pHeap->m_iElementSize * nCount;
+
+    Heap_SetLen(pHeap, nCount + 1);
+
+    if(bAliased == true)
+    {
+        void* pScratch = Heap_At(pHeap, nCount + 1);
+        memcpy(pScratch, (uint8_t*)pHeap->m_pData + (iValue - iData), pHeap->m_iElementSize);
+        pValue = pScratch;
+    }
+
+    Heap_SiftUp(pHeap, nCount, pValue, iSlot);
+
+    return hHandle;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool Heap_Pop(Heap_t* pHeap, void* pOut)
+{
+    uint32_t nCount = Heap_Len(pHeap);
+    if(nCount == 0)
+        return false;
+
+    if(pOut != nullptr)
+        memcpy(pOut, pHeap->m_pData, pHeap->m_iElementSize);
+
+    if(pHeap->m_bTrackHandles == true)
+        Heap_ReleaseSlot(pHeap, pHeap->m_pSlots[0]);
+
+
+    // Sift last entry down from the root. Holes never reach the last slot, so we can read it in place.
+    uint32_t iLast = nCount - 1;
+    Heap_SetLen(pHeap, iLast);
+
+    if(iLast > 0)
+        Heap_SiftDown(pHeap, 0, Heap_At(pHeap, iLast), Heap_SlotAt(pHeap, iLast), iLast);
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t Heap_PopMany(Heap_t* pHeap, void* pOut, uint32_t nMax)
+{
+    uint32_t nPopped = 0;
+    while(nPopped < nMax && Heap_Pop(pHeap, (uint8_t*)pOut + pHeap->m_iElementSize * nPopped) == true)
+        nPopped++;
+
+    return nPopped;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool Heap_Contains(Heap_t* pHeap, HeapHandle_t hHandle)
+{
+    assertion(pHeap->m_bTrackHandles == true && "Heap doesn't track handles");
+
+    uint32_t iSlot       = (uint32_t)hHandle;
+    uint32_t iGeneration = (uint32_t)(hHandle >> HEAP_SLOT_BITS);
+
+    return iSlot < Vector_Len(pHeap->m_pPositions)         &&
+           pHeap->m_pGenerations[iSlot] == iGeneration     &&
+           pHeap->m_pPositions[iSlot] != HEAP_INVALID_POSITION;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* Heap_Get(Heap_t* pHeap, HeapHandle_t hHandle)
+{
+    assertion(Heap_Contains(pHeap, hHandle) == true && "Stale heap handle");
+
+    return Heap_At(pHeap, pHeap->m_pPositions[(uint32_t)hHandle]);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_Update(Heap_t* pHeap, HeapHandle_t hHandle, const void* pValue)
+{
+    assertion(Heap_Contains(pHeap, hHandle) == true && "Stale heap handle");
+
+    uint32_t iSlot     = (uint32_t)hHandle;
+    uint32_t nCount    = Heap_Len(pHeap);
+    uint32_t iPosition = pHeap->m_pPositions[iSlot];
+
+    // PVALUE may well be pointing at the entry itself, so work from a copy.
+    void* pScratch = Heap_At(pHeap, nCount);
+    memcpy(pScratch, pValue, pHeap->m_iElementSize);
+
+    if(pHeap->m_pCompare(pScratch, Heap_At(pHeap, iPosition)) < 0)
+        Heap_SiftUp  (pHeap, iPosition, pScratch, iSlot);
+    else
+        Heap_SiftDown(pHeap, iPosition, pScratch, iSlot, nCount);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Heap_Erase(Heap_t* pHeap, HeapHandle_t hHandle)
+{
+    assertion(Heap_Contains(pHeap, hHandle) == true && "Stale heap handle");
+
+    uint32_t iSlot     = (uint32_t)hHandle;
+    uint32_t iPosition = pHeap->m_pPositions[iSlot];
+    uint32_t iLast     = Heap_Len(pHeap) - 1;
+
+    Heap_ReleaseSlot(pHeap, iSlot);
+    Heap_SetLen(pHeap, iLast);
+
+    if(iPosition == iLast)
+        return;
+
+
+    // Fill the hole with last entry. It may need to go either way.
+    void*    pLastValue  = Heap_At(pHeap, iLast);
+    uint32_t iLastSlot   = Heap_SlotAt(pHeap, iLast);
+
+    if(pHeap->m_pCompare(pLastValue, Heap_At(pHeap, iPosition)) < 0)
+        Heap_SiftUp  (pHeap, iPosition, pLastValue, iLastSlot);
+    else
+        Heap_SiftDown(pHeap, iPosition, pLastValue, iLastSlot, iLast);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* Heap_TopVerified(Heap_t* pHeap, size_t iElementSize)
+{
+    assertion(pHeap->m_iElementSize == iElementSize && "Type doesn't match Heap's element size");
+    return Heap_Top(pHeap);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static inline void KeyHeap_SiftDown(int64_t* pHeap, uint32_t iHole, int64_t iKey, uint32_t nCount)
+{
+    while(true)
+    {
+        uint32_t iFirstChild = iHole * HEAP_KEY_ARITY + 1;
+        if(iFirstChild >= nCount)
+            break;
+
+        uint32_t iLastChild = iFirstChild + HEAP_KEY_ARITY;
+        if(iLastChild > nCount)
+            iLastChild = nCount;
+
+        uint32_t iBest = iFirstChild;
+        for(uint32_t iChild = iFirstChild + 1; iChild < iLastChild; iChild++)
+        {
+            if(pHeap[iChild] < pHeap[iBest])
+                iBest = iChild;
+        }
+
+        if(pHeap[iBest] >= iKey)
+            break;
+
+        pHeap[iHole] = pHeap[iBest];
+        iHole        = iBest;
+    }
+
+    pHeap[iHole] = iKey;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void KeyHeap_Push(int64_t** ppHeap, int64_t iKey)
+{
+    Vector_PushBack(*ppHeap, iKey);
+
+    int64_t* pHeap = *ppHeap;
+    uint32_t iHole = Vector_Len(pHeap) - 1;
+
+    while(iHole > 0)
+    {
+        uint32_t iParent = (iHole - 1) / HEAP_KEY_ARITY;
+        if(pHeap[iParent] <= iKey)
+            break;
+
+        pHeap[iHole] = pHeap[iParent];
+        iHole        = iParent;
+    }
+
+    pHeap[iHole] = iKey;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static int64_t KeyHeap_Pop(int64_t* pHeap)
+{
+    uint32_t nCount = Vector_Len(pHeap);
+    assertion(nCount > 0 && "Empty heap");
+
+    int64_t iTop = pHeap[0];
+    Vector_PopBack(pHeap);
+
+    if(nCount > 1)
+        KeyHeap_SiftDown(pHeap, 0, pHeap[nCount - 1], nCount - 1);
+
+    return iTop;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static int64_t KeyHeap_Top(int64_t* pHeap)
+{
+    assertion(Vector_Len(pHeap) > 0 && "Empty heap");
+    return pHeap[0];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t KeyHeap_PopMany(int64_t* pHeap, int64_t* pOut, uint32_t nMax)
+{
+    uint32_t nPopped = 0;
+    while(nPopped < nMax && Vector_Len(pHeap) > 0)
+        pOut[nPopped++] = KeyHeap_Pop(pHeap);
+
+    return nPopped;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void KeyHeap_Heapify(int64_t* pHeap)
+{
+    uint32_t nCount = Vector_Len(pHeap);
+    if(nCount < 2)
+        return;
+
+    for(uint32_t iIndex = (nCount - 2) / HEAP_KEY_ARITY + 1; iIndex > 0; iIndex--)
+        KeyHeap_SiftDown(pHeap, iIndex - 1, pHeap[iIndex - 1], nCount);
+}
+
+
+#endif
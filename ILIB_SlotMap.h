@@ -0,0 +1,369 @@
+//=========================================================================
+//                      ILIB Slot Map
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Slot map in C. Stable generational handles to values that are
+//           kept densely packed in an ILIB vector.
+//-------------------------------------------------------------------------
+#ifndef ILIB_SLOT_MAP_H
+#define ILIB_SLOT_MAP_H
+
+
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+
+
+#ifndef __cplusplus
+#define nullptr               ((void*)0)
+#endif
+#define SLOTMAP_INVALID_INDEX (0xFFFFFFFF)
+#define SLOTMAP_NULL_HANDLE   (0)          // Never handed out, generations start at 1.
+
+
+/* 64 bit handles : 32 bit index, 32 bit generation.
+ * 32 bit handles : 20 bit index ( ~1M live slots ), 12 bit generation ( stale handles are caught until a slot is reused 4095 times ). */
+#ifndef SLOTMAP_HANDLE_BITS
+#define SLOTMAP_HANDLE_BITS (64)
+#endif
+
+#if (SLOTMAP_HANDLE_BITS == 64)
+typedef uint64_t SlotHandle_t;
+#define SLOTMAP_INDEX_BITS  (32)
+#elif (SLOTMAP_HANDLE_BITS == 32)
+typedef uint32_t SlotHandle_t;
+#define SLOTMAP_INDEX_BITS  (20)
+#else
+#error "SLOTMAP_HANDLE_BITS must be 32 or 64"
+#endif
+
+#define SLOTMAP_INDEX_MASK      ((uint32_t)(((uint64_t)1 << SLOTMAP_INDEX_BITS) - 1))
+#define SLOTMAP_GENERATION_MASK ((uint32_t)(((uint64_t)1 << (SLOTMAP_HANDLE_BITS - SLOTMAP_INDEX_BITS)) - 1))
+
+/*
+
+Slot Map Structure :
+    Slots   : [ dense index, gen ][ dense index, gen ][ next free, gen ]...  <- handle's index points here.
+    Values  : [ Value 0 ][ Value 1 ]...                                      <- always packed, iterate this.
+    Owners  : [ slot of value 0 ][ slot of value 1 ]...                      <- to fix slots after a swap-remove.
+
+Erasing moves the last value into the hole, so values stay packed but their order isn't kept.
+Every erase bumps the slot's generation, so handles to erased values stop resolving.
+
+*/
+
+
+/* Typed pointer to value behind HHANDLE, or nullptr if handle is stale. Verifies sizeof(TYPE). */
+#define SlotMap_GetAs(pSlotMap, Type, hHandle) ((Type*)SlotMap_GetVerified((pSlotMap), (hHandle), sizeof(Type)))
+
+
+/* Typed pointer to first packed value, iterate up to SlotMap_Len(). Verifies sizeof(TYPE). */
+#define SlotMap_ValuesAs(pSlotMap, Type) ((Type*)SlotMap_ValuesVerified((pSlotMap), sizeof(Type)))
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct SlotMapSlot_t
+{
+    uint32_t m_iIndex;      // Index into values if slot is live, else next free slot.
+    uint32_t m_iGeneration; // Bumped on every erase.
+
+} SlotMapSlot_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct SlotMap_t
+{
+    SlotMapSlot_t* m_pSlots;       // ISTDLIB vector, indexed by handle.
+    void*          m_pValues;      // ISTDLIB vector of packed values, m_iElementSize bytes each.
+    uint32_t*      m_pOwners;      // ISTDLIB vector, slot index of each packed value.
+
+    uint32_t       m_iFreeHead;    // First free slot, SLOTMAP_INVALID_INDEX if none.
+    size_t         m_iElementSize;
+
+} SlotMap_t;
+
+
+/* Initialize empty slot map holding values of IELEMENTSIZE bytes. Doesn't allocate. */
+static void SlotMap_Initialize(SlotMap_t* pSlotMap, size_t iElementSize);
+
+/* Free all memory and uninitialize this SlotMap. */
+static void SlotMap_Free(SlotMap_t* pSlotMap);
+
+/* Copy PVALUE in ( zeroed if PVALUE is nullptr ) and return a handle to it. O(1). */
+static SlotHandle_t SlotMap_Insert(SlotMap_t* pSlotMap, const void* pValue);
+
+/* Erase value behind HHANDLE. Returns false if handle is stale. O(1). */
+static bool SlotMap_Erase(SlotMap_t* pSlotMap, SlotHandle_t hHandle);
+
+/* Pointer to value behind HHANDLE, or nullptr if handle is stale. O(1). Invalidated by insert & erase. */
+static void* SlotMap_Get(SlotMap_t* pSlotMap, SlotHandle_t hHandle);
+
+/* Does HHANDLE still point to a live value ? */
+static bool SlotMap_Contains(SlotMap_t* pSlotMap, SlotHandle_t hHandle);
+
+/* Number of live values. */
+static uint32_t SlotMap_Len(SlotMap_t* pSlotMap);
+
+/* Pointer to first packed value. */
+static void* SlotMap_Values(SlotMap_t* pSlotMap);
+
+/* Handle of packed value at IVALUEINDEX, 0 <= IVALUEINDEX < SlotMap_Len(). */
+static SlotHandle_t SlotMap_HandleAt(SlotMap_t* pSlotMap, uint32_t iValueIndex);
+
+/* Erase everything. All handles handed out so far go stale, memory is kept. */
+static void SlotMap_Clear(SlotMap_t* pSlotMap);
+
+/* Same as SlotMap_Get(), asserts IELEMENTSIZE matches. Used by SlotMap_GetAs(). */
+static void* SlotMap_GetVerified(SlotMap_t* pSlotMap, SlotHandle_t hHandle, size_t iElementSize);
+
+/* Same as SlotMap_Values(), asserts IELEMENTSIZE matches. Used by SlotMap_ValuesAs(). */
+static void* SlotMap_ValuesVerified(SlotMap_t* pSlotMap, size_t iElementSize);
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static SlotHandle_t SlotMap_MakeHandle(uint32_t iSlot, uint32_t iGeneration)
+{
+    return ((SlotHandle_t)iGeneration << SLOTMAP_INDEX_BITS) | (SlotHandle_t)iSlot;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t SlotMap_NextGeneration(uint32_t iGeneration)
+{
+    // Generation 0 is never used, that is what keeps SLOTMAP_NULL_HANDLE invalid.
+    iGeneration = (iGeneration + 1) & SLOTMAP_GENERATION_MASK;
+    return iGeneration == 0 ? 1 : iGeneration;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SlotMap_Initialize(SlotMap_t* pSlotMap, size_t iElementSize)
+{
+    assertion(iElementSize > 0 && "SlotMap with 0 sized elements");
+
+    pSlotMap->m_pSlots       = NULL;
+    pSlotMap->m_pValues      = NULL;
+    pSlotMap->m_pOwners      = NULL;
+    pSlotMap->m_iFreeHead    = SLOTMAP_INVALID_INDEX;
+    pSlotMap->m_iElementSize = iElementSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SlotMap_Free(SlotMap_t* pSlotMap)
+{
+    Vector_Free(pSlotMap->m_pSlots);
+    Vector_Free(pSlotMap->m_pOwners);
+
+    // Untyped vector, can't use the macro.
+    if(pSlotMap->m_pValues != nullptr)
+    {
+        Vector_VerifyRequest(&pSlotMap->m_pValues, pSlotMap->m_iElementSize, 0, false);
+        free(Vector_GetHeader(pSlotMap->m_pValues));
+        pSlotMap->m_pValues = NULL;
+    }
+
+    pSlotMap->m_iFreeHead = SLOTMAP_INVALID_INDEX;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static SlotHandle_t SlotMap_Insert(SlotMap_t* pSlotMap, const void* pValue)
+{
+    uint32_t iValueIndex = Vector_Len(pSlotMap->m_pOwners);
+
+
+    // Reuse a free slot if we have one.
+    uint32_t iSlot = pSlotMap->m_iFreeHead;
+    if(iSlot != SLOTMAP_INVALID_INDEX)
+    {
+        pSlotMap->m_iFreeHead = pSlotMap->m_pSlots[iSlot].m_iIndex;
+    }
+    else
+    {
+        iSlot = Vector_Len(pSlotMap->m_pSlots);
+        assertion(iSlot < SLOTMAP_INDEX_MASK && "SlotMap is out of handle index bits");
+
+        SlotMapSlot_t slot = { 0, 1 };
+        Vector_PushBack(pSlotMap->m_pSlots, slot);
+    }
+
+    SlotMapSlot_t* pSlot = &pSlotMap->m_pSlots[iSlot];
+    pSlot->m_iIndex      = iValueIndex;
+
+
+    // Append value & its owner. PVALUE may point into our own values ( SlotMap_Insert(m, SlotMap_Get(m, h)) ),
+    // growing can move it, so find it again in the new block.
+    uintptr_t iValues  = (uintptr_t)pSlotMap->m_pValues;
+    uintptr_t iValue   = (uintptr_t)pValue;
+    bool      bAliased = pSlotMap->m_pValues != nullptr && iValue >= iValues && iValue < iValues + pSlotMap->m_iElementSize * iValueIndex;
+
+    Vector_AssertInit    (&pSlotMap->m_pValues, pSlotMap->m_iElementSize);
+    Vector_MayGrowToIndex(&pSlotMap->m_pValues, pSlotMap->m_iElementSize, (int)iValueIndex);
+
+    if(bAliased == true)
+        pValue = (uint8_t*)pSlotMap->m_pValues + (iValue - iValues);
+
+    void* pDest = (uint8_t*)pSlotMap->m_pValues + pSlotMap->m_iElementSize * iValueIndex;
+    if(pValue != nullptr)
+        memcpy(pDest, pValue, pSlotMap->m_iElementSize);
+    else
+        memset(pDest, 0, pSlotMap->m_iElementSize);
+
+    Vector_GetHeader(pSlotMap->m_pValues)->m_iSize = iValueIndex + 1;
+    Vector_PushBack(pSlotMap->m_pOwners, iSlot);
+
+
+    return SlotMap_MakeHandle(iSlot, pSlot->m_iGeneration);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool SlotMap_Erase(SlotMap_t* pSlotMap, SlotHandle_t hHandle)
+{
+    if(SlotMap_Contains(pSlotMap, hHandle) == false)
+        return false;
+
+    uint32_t       iSlot       = (uint32_t)(hHandle & SLOTMAP_INDEX_MASK);
+    SlotMapSlot_t* pSlot       = &pSlotMap->m_pSlots[iSlot];
+    uint32_t       iValueIndex = pSlot->m_iIndex;
+    uint32_t       iLastIndex  = Vector_Len(pSlotMap->m_pOwners) - 1;
+
+
+    // Move last value into the hole & point its slot to new place.
+    if(iValueIndex != iLastIndex)
+    {
+        size_t   iElementSize = pSlotMap->m_iElementSize;
+        uint8_t* pValues      = (uint8_t*)pSlotMap->m_pValues;
+        memcpy(pValues + iElementSize * iValueIndex, pValues + iElementSize * iLastIndex, iElementSize);
+
+        uint32_t iMovedSlot                         = pSlotMap->m_pOwners[iLastIndex];
+        pSlotMap->m_pOwners[iValueIndex]            = iMovedSlot;
+        pSlotMap->m_pSlots[iMovedSlot].m_iIndex     = iValueIndex;
+    }
+
+    Vector_PopBack(pSlotMap->m_pOwners);
+    Vector_GetHeader(pSlotMap->m_pValues)->m_iSize = iLastIndex;
+
+
+    // Kill all handles to this slot & put it on the free list.
+    pSlot->m_iGeneration  = SlotMap_NextGeneration(pSlot->m_iGeneration);
+    pSlot->m_iIndex       = pSlotMap->m_iFreeHead;
+    pSlotMap->m_iFreeHead = iSlot;
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* SlotMap_Get(SlotMap_t* pSlotMap, SlotHandle_t hHandle)
+{
+    if(SlotMap_Contains(pSlotMap, hHandle) == false)
+        return nullptr;
+
+    uint32_t iSlot = (uint32_t)(hHandle & SLOTMAP_INDEX_MASK);
+    return (uint8_t*)pSlotMap->m_pValues + pSlotMap->m_iElementSize * pSlotMap->m_pSlots[iSlot].m_iIndex;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool SlotMap_Contains(SlotMap_t* pSlotMap, SlotHandle_t hHandle)
+{
+    uint32_t iSlot       = (uint32_t)(hHandle & SLOTMAP_INDEX_MASK);
+    uint32_t iGeneration = (uint32_t)(hHandle >> SLOTMAP_INDEX_BITS) & SLOTMAP_GENERATION_MASK;
+
+    // Free slots always have a newer generation than any handle given out for them.
+    return iSlot < Vector_Len(pSlotMap->m_pSlots) && pSlotMap->m_pSlots[iSlot].m_iGeneration == iGeneration;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t SlotMap_Len(SlotMap_t* pSlotMap)
+{
+    return Vector_Len(pSlotMap->m_pOwners);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* SlotMap_Values(SlotMap_t* pSlotMap)
+{
+    return pSlotMap->m_pValues;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static SlotHandle_t SlotMap_HandleAt(SlotMap_t* pSlotMap, uint32_t iValueIndex)
+{
+    assertion(iValueIndex < Vector_Len(pSlotMap->m_pOwners) && "Out of bound");
+
+    uint32_t iSlot = pSlotMap->m_pOwners[iValueIndex];
+    return SlotMap_MakeHandle(iSlot, pSlotMap->m_pSlots[iSlot].m_iGeneration);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SlotMap_Clear(SlotMap_t* pSlotMap)
+{
+    // Bump live slots only, free ones were bumped when they got erased.
+    for(uint32_t iValueIndex = 0; iValueIndex < Vector_Len(pSlotMap->m_pOwners); iValueIndex++)
+    {
+        SlotMapSlot_t* pSlot = &pSlotMap->m_pSlots[pSlotMap->m_pOwners[iValueIndex]];
+        pSlot->m_iGeneration = SlotMap_NextGeneration(pSlot->m_iGeneration);
+    }
+
+
+    // Rebuild free list with every slot, lowest index first.
+    pSlotMap->m_iFreeHead = SLOTMAP_INVALID_INDEX;
+    for(uint32_t iSlot = Vector_Len(pSlotMap->m_pSlots); iSlot > 0; iSlot--)
+    {
+        pSlotMap->m_pSlots[iSlot - 1].m_iIndex = pSlotMap->m_iFreeHead;
+        pSlotMap->m_iFreeHead                  = iSlot - 1;
+    }
+
+    Vector_Clear(pSlotMap->m_pOwners);
+    if(pSlotMap->m_pValues != nullptr)
+        Vector_GetHeader(pSlotMap->m_pValues)->m_iSize = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* SlotMap_GetVerified(SlotMap_t* pSlotMap, SlotHandle_t hHandle, size_t iElementSize)
+{
+    assertion(pSlotMap->m_iElementSize == iElementSize && "Type doesn't match SlotMap's element size");
+    return SlotMap_Get(pSlotMap, hHandle);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* SlotMap_ValuesVerified(SlotMap_t* pSlotMap, size_t iElementSize)
+{
+    assertion(pSlotMap->m_iElementSize == iElementSize && "Type doesn't match SlotMap's element size");
+    return pSlotMap->m_pValues;
+}
+
+
+#endif
@@ -0,0 +1,333 @@
+//=========================================================================
+//                      ILIB SoA
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Structure-of-arrays container in C. Every field lives in its own
+//           aligned column, all columns grow & shrink together.
+//-------------------------------------------------------------------------
+#ifndef ILIB_SOA_H
+#define ILIB_SOA_H
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+
+
+#ifndef __cplusplus
+#define nullptr              ((void*)0)
+#endif
+#define SOA_MAX_COLUMNS      (16)
+#define SOA_COLUMN_ALIGNMENT (64)   // Every column starts on a cache line, good for any SIMD width up to AVX-512.
+#define SOA_SIGNATURE        (0x50A50A50)
+
+/*
+
+SoA Structure :
+    [ Column 0 ][ pad ][ Column 1 ][ pad ][ Column 2 ][ pad ]...
+
+All columns live in one aligned block & share one size / capacity, same as VectorHeader_t does
+for a vector. Each column is padded up to SOA_COLUMN_ALIGNMENT bytes, so SIMD kernels can read
+whole vectors past SoA_Len() up to the padding without going out of the block.
+
+Columns are moved to new offsets when capacity changes, so don't hold on to column pointers
+across SoA_PushBack() / SoA_Reserve() / SoA_Resize().
+
+*/
+
+
+/* Typed pointer to first element of column ICOLUMN. Verifies sizeof(TYPE) against column's element size. */
+#define SoA_Column(pSoA, Type, iColumn) ((Type*)SoA_GetColumn((pSoA), (iColumn), sizeof(Type)))
+
+
+/* Element IROW of column ICOLUMN as an lvalue. Verified, use SoA_Column() in hot loops instead. */
+#define SoA_At(pSoA, Type, iColumn, iRow) (SoA_Column((pSoA), Type, (iColumn))[(iRow)])
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct SoA_t
+{
+    void*    m_pMemory;                         // One aligned block holding every column.
+    void*    m_aColumns[SOA_MAX_COLUMNS];       // Start of each column inside m_pMemory.
+    uint32_t m_aElementSizes[SOA_MAX_COLUMNS];  // Size of one element of each column.
+
+    uint32_t m_nColumns;    // Number of columns in use.
+    uint32_t m_iSize;       // Rows stored.
+    uint32_t m_iCapacity;   // Rows that fit without reallocating.
+    uint32_t m_iSignature;  // Signature to help us prevent mistakes.
+
+} SoA_t;
+
+
+/* Initialize SoA with NCOLUMNS columns, element size of column i is PELEMENTSIZES[i]. Doesn't allocate. */
+static bool SoA_Initialize(SoA_t* pSoA, int nColumns, const size_t* pElementSizes);
+
+/* Free all columns and uninitialize this SoA. */
+static void SoA_Free(SoA_t* pSoA);
+
+/* Pointer to first element of column ICOLUMN. Asserts IELEMENTSIZE matches the column. */
+static void* SoA_GetColumn(SoA_t* pSoA, int iColumn, size_t iElementSize);
+
+/* Number of rows stored. */
+static uint32_t SoA_Len(SoA_t* pSoA);
+
+/* Number of rows that fit without reallocating. */
+static uint32_t SoA_Capacity(SoA_t* pSoA);
+
+/* Grow all columns so they can hold ICAPACITY rows. */
+static void SoA_Reserve(SoA_t* pSoA, uint32_t iCapacity);
+
+/* Set row count to ISIZE, growing if required. New rows are zeroed. */
+static void SoA_Resize(SoA_t* pSoA, uint32_t iSize);
+
+/* Append one zeroed row & return its index. Grows by STD_VECTOR_GROWTH when full. */
+static uint32_t SoA_PushBack(SoA_t* pSoA);
+
+/* Append one row, PPVALUES[i] points to value for column i. Returns its index. */
+static uint32_t SoA_PushBackRow(SoA_t* pSoA, const void* const* ppValues);
+
+/* Remove last row. */
+static void SoA_PopBack(SoA_t* pSoA);
+
+/* Remove row IROW by moving last row into it, in every column. O(columns), doesn't keep order. */
+static void SoA_SwapRemove(SoA_t* pSoA, uint32_t iRow);
+
+/* Set row count to 0. Keeps capacity. */
+static void SoA_Clear(SoA_t* pSoA);
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static size_t SoA_AlignUp(size_t iBytes)
+{
+    return ((iBytes + (SOA_COLUMN_ALIGNMENT - 1)) / SOA_COLUMN_ALIGNMENT) * SOA_COLUMN_ALIGNMENT;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_VerifyRequest(SoA_t* pSoA)
+{
+    assertion(pSoA->m_iSignature == SOA_SIGNATURE && "Uninitialized or corrupted SoA");
+    assertion(pSoA->m_iSize <= pSoA->m_iCapacity  && "SoA has Corrupted Metadata");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool SoA_Initialize(SoA_t* pSoA, int nColumns, const size_t* pElementSizes)
+{
+    assertion(nColumns > 0 && nColumns <= SOA_MAX_COLUMNS && "Invalid column count");
+    if(nColumns <= 0 || nColumns > SOA_MAX_COLUMNS)
+        return false;
+
+    memset(pSoA, 0, sizeof(SoA_t));
+
+    for(int iColumn = 0; iColumn < nColumns; iColumn++)
+    {
+        assertion(pElementSizes[iColumn] > 0 && "Column with 0 sized elements");
+        pSoA->m_aElementSizes[iColumn] = (uint32_t)pElementSizes[iColumn];
+    }
+
+    pSoA->m_nColumns   = (uint32_t)nColumns;
+    pSoA->m_iSignature = SOA_SIGNATURE;
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_Free(SoA_t* pSoA)
+{
+    free(pSoA->m_pMemory);
+    memset(pSoA, 0, sizeof(SoA_t));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* SoA_GetColumn(SoA_t* pSoA, int iColumn, size_t iElementSize)
+{
+    SoA_VerifyRequest(pSoA);
+    assertion(iColumn >= 0 && iColumn < (int)pSoA->m_nColumns    && "Out of bound column");
+    assertion(pSoA->m_aElementSizes[iColumn] == iElementSize     && "Column type doesn't match column's element size");
+
+    return pSoA->m_aColumns[iColumn];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t SoA_Len(SoA_t* pSoA)
+{
+    return pSoA->m_iSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t SoA_Capacity(SoA_t* pSoA)
+{
+    return pSoA->m_iCapacity;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_Reserve(SoA_t* pSoA, uint32_t iCapacity)
+{
+    SoA_VerifyRequest(pSoA);
+
+    // We already have requested capacity.
+    if(pSoA->m_iCapacity >= iCapacity)
+        return;
+
+
+    // One block for all columns. Column offsets depend on capacity, so every column
+    // gets copied to its new place, realloc() wouldn't save us anything here.
+    size_t iTotalSize = 0;
+    for(uint32_t iColumn = 0; iColumn < pSoA->m_nColumns; iColumn++)
+    {
+        iTotalSize += SoA_AlignUp((size_t)pSoA->m_aElementSizes[iColumn] * iCapacity);
+    }
+
+    uint8_t* pNewMemory = (uint8_t*)aligned_alloc(SOA_COLUMN_ALIGNMENT, iTotalSize);
+    assertion(pNewMemory != nullptr && "You made aligned_alloc() fail. Consider touching some grass now.");
+
+
+    size_t iOffset = 0;
+    for(uint32_t iColumn = 0; iColumn < pSoA->m_nColumns; iColumn++)
+    {
+        size_t iColumnSize = SoA_AlignUp((size_t)pSoA->m_aElementSizes[iColumn] * iCapacity);
+
+        if(pSoA->m_iSize > 0)
+            memcpy(pNewMemory + iOffset, pSoA->m_aColumns[iColumn], (size_t)pSoA->m_aElementSizes[iColumn] * pSoA->m_iSize);
+
+        pSoA->m_aColumns[iColumn] = pNewMemory + iOffset;
+        iOffset                  += iColumnSize;
+    }
+
+
+    free(pSoA->m_pMemory);
+    pSoA->m_pMemory   = pNewMemory;
+    pSoA->m_iCapacity = iCapacity;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_Resize(SoA_t* pSoA, uint32_t iSize)
+{
+    SoA_Reserve(pSoA, iSize);
+
+    // Zero out new rows in every column.
+    if(iSize > pSoA->m_iSize)
+    {
+        for(uint32_t iColumn = 0; iColumn < pSoA->m_nColumns; iColumn++)
+        {
+            size_t iElementSize = pSoA->m_aElementSizes[iColumn];
+            memset((uint8_t*)pSoA->m_aColumns[iColumn] + iElementSize * pSoA->m_iSize, 0, iElementSize * (iSize - pSoA->m_iSize));
+        }
+    }
+
+    pSoA->m_iSize = iSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t SoA_PushBack(SoA_t* pSoA)
+{
+    SoA_VerifyRequest(pSoA);
+
+    if(pSoA->m_iSize == pSoA->m_iCapacity)
+        SoA_Reserve(pSoA, pSoA->m_iCapacity == 0 ? STD_VECTOR_CAPACITY : pSoA->m_iCapacity * STD_VECTOR_GROWTH);
+
+    uint32_t iRow = pSoA->m_iSize;
+    for(uint32_t iColumn = 0; iColumn < pSoA->m_nColumns; iColumn++)
+    {
+        size_t iElementSize = pSoA->m_aElementSizes[iColumn];
+        memset((uint8_t*)pSoA->m_aColumns[iColumn] + iElementSize * iRow, 0, iElementSize);
+    }
+
+    pSoA->m_iSize++;
+    return iRow;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint32_t SoA_PushBackRow(SoA_t* pSoA, const void* const* ppValues)
+{
+    SoA_VerifyRequest(pSoA);
+
+    if(pSoA->m_iSize == pSoA->m_iCapacity)
+        SoA_Reserve(pSoA, pSoA->m_iCapacity == 0 ? STD_VECTOR_CAPACITY : pSoA->m_iCapacity * STD_VECTOR_GROWTH);
+
+    uint32_t iRow = pSoA->m_iSize;
+    for(uint32_t iColumn = 0; iColumn < pSoA->m_nColumns; iColumn++)
+    {
+        size_t iElementSize = pSoA->m_aElementSizes[iColumn];
+        memcpy((uint8_t*)pSoA->m_aColumns[iColumn] + iElementSize * iRow, ppValues[iColumn], iElementSize);
+    }
+
+    pSoA->m_iSize++;
+    return iRow;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_PopBack(SoA_t* pSoA)
+{
+    SoA_VerifyRequest(pSoA);
+    assertion(pSoA->m_iSize > 0 && "Empty SoA");
+
+    pSoA->m_iSize--;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_SwapRemove(SoA_t* pSoA, uint32_t iRow)
+{
+    SoA_VerifyRequest(pSoA);
+    assertion(pSoA->m_iSize > 0    && "Empty SoA");
+    assertion(iRow < pSoA->m_iSize && "Trying to erase out of bound row");
+
+    uint32_t iLastRow = pSoA->m_iSize - 1;
+    if(iRow != iLastRow)
+    {
+        for(uint32_t iColumn = 0; iColumn < pSoA->m_nColumns; iColumn++)
+        {
+            size_t   iElementSize = pSoA->m_aElementSizes[iColumn];
+            uint8_t* pColumn      = (uint8_t*)pSoA->m_aColumns[iColumn];
+
+            memcpy(pColumn + iElementSize * iRow, pColumn + iElementSize * iLastRow, iElementSize);
+        }
+    }
+
+    pSoA->m_iSize--;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void SoA_Clear(SoA_t* pSoA)
+{
+    pSoA->m_iSize = 0;
+}
+
+
+#endif
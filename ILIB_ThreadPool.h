@@ -0,0 +1,802 @@
+//=========================================================================
+//                      ILIB Thread Pool
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Work-stealing thread pool in C, with parallel for / reduce / sort
+//           over ILIB vectors. C11 only, doesn't build as C++.
+//-------------------------------------------------------------------------
+#ifndef ILIB_THREAD_POOL_H
+#define ILIB_THREAD_POOL_H
+
+#ifdef __cplusplus
+#error "ILIB_ThreadPool.h is C only, it is built on C11 <stdatomic.h>"
+#endif
+
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#include "ILIB_Assertion.h"
+#include "ILIB_Vector.h"
+#include "ILIB_ArenaAllocator.h"
+
+
+#define nullptr                          ((void*)0)
+#define THREADPOOL_OWNER                 (0)          // Worker index of the thread that owns the pool.
+#define THREADPOOL_DEQUE_CAPACITY        (1024)       // Tasks per worker deque. Must be power of 2.
+#define THREADPOOL_SCRATCH_SIZE          (1024 * 64)  // Arena size of each worker's scratch allocator.
+#define THREADPOOL_SPIN_COUNT            (64)         // Failed steal rounds before a worker goes to sleep.
+#define THREADPOOL_TASKS_PER_WORKER      (8)          // Default grain aims for this many ranges per worker.
+#define THREADPOOL_MIN_GRAIN             (1024)       // Never split ranges below this many elements by default.
+#define THREADPOOL_MAX_REDUCE_SIZE       (256)        // Max size of a reduction accumulator in bytes.
+
+/*
+
+Pool Structure :
+    [ Worker 0 ( owner thread ) ][ Worker 1 ][ Worker 2 ]...
+
+Worker 0 is the thread that initialized the pool, it runs tasks only while
+it is inside ThreadPool_Wait(). Workers 1..N-1 are pthreads.
+
+Each worker has its own deque. Owner of the deque pushes & pops at the bottom ( LIFO ),
+other workers steal from the top ( FIFO ), so thieves take the biggest chunks of
+recursively split work first.
+
+Every function that submits or waits takes the worker index of the CALLING thread. Tasks
+get their worker index as an argument, use THREADPOOL_OWNER from the owner thread.
+
+*/
+
+
+/* Parallel for over a whole ILIB vector. FUNCTION is ThreadPoolRangeFn_t. Call from the owner thread. */
+#define Vector_ParallelFor(pPool, Container, Function, pContext)                       \
+    ThreadPool_ParallelFor((pPool), THREADPOOL_OWNER, (void*)(Container),               \
+            (int)Vector_Len(Container), 0, (Function), (pContext))
+
+
+/* Parallel reduce over a whole ILIB vector. PRESULT holds identity on input and result on output. */
+#define Vector_ParallelReduce(pPool, Container, pResult, Reduce, Combine, pContext)       \
+    ThreadPool_ParallelReduce((pPool), THREADPOOL_OWNER, (void*)(Container),               \
+            (int)Vector_Len(Container), 0, (void*)(pResult), sizeof(*(pResult)),           \
+            (Reduce), (Combine), (pContext))
+
+
+/* Parallel stable merge sort of a whole ILIB vector. COMPARE is a qsort() style comparator. */
+#define Vector_ParallelSort(pPool, Container, Compare)                                  \
+    ThreadPool_ParallelSort((pPool), THREADPOOL_OWNER, (void*)(Container),              \
+            (int)Vector_Len(Container), sizeof(*(Container)), (Compare))
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef void (*ThreadPoolTaskFn_t)(void* pContext, int iWorkerIndex);
+
+/* Process elements [IBEGIN, IEND) of PCONTAINER. */
+typedef void (*ThreadPoolRangeFn_t)(void* pContainer, int iBegin, int iEnd, void* pContext, int iWorkerIndex);
+
+/* Fold elements [IBEGIN, IEND) of PCONTAINER into PACCUMULATOR. */
+typedef void (*ThreadPoolReduceFn_t)(void* pContainer, int iBegin, int iEnd, void* pAccumulator, void* pContext);
+
+/* Fold POTHER into PACCUMULATOR. */
+typedef void (*ThreadPoolCombineFn_t)(void* pAccumulator, const void* pOther, void* pContext);
+
+/* qsort() style comparator. */
+typedef int (*ThreadPoolCompareFn_t)(const void* pLeft, const void* pRight);
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPoolCounter_t
+{
+    atomic_int m_nPending; // Tasks submitted against this counter and not finished yet.
+
+} ThreadPoolCounter_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPoolTask_t
+{
+    ThreadPoolTaskFn_t   m_pFunction;
+    void*                m_pContext;
+    ThreadPoolCounter_t* m_pCounter;  // Decremented once this task is done.
+
+} ThreadPoolTask_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPoolWorker_t
+{
+    ThreadPoolTask_t     m_aTasks[THREADPOOL_DEQUE_CAPACITY]; // Ring buffer.
+    _Atomic int64_t      m_iTop;      // Thieves steal from here. ( oldest task )
+    _Atomic int64_t      m_iBottom;   // Owner pushes & pops here. ( newest task )
+    pthread_mutex_t      m_mutex;     // Guards writes to m_iTop, m_iBottom & m_aTasks. Indices are atomic only for unlocked peeking.
+
+    pthread_t            m_thread;    // Unused for worker 0.
+    ArenaAllocator_t     m_scratch;   // Scratch memory, only ever touched by this worker.
+
+    struct ThreadPool_t* m_pPool;
+    int                  m_iIndex;
+
+    char                 m_padding[64]; // Keep hot deque indices of neighbouring workers off the same cache line.
+
+} ThreadPoolWorker_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPool_t
+{
+    ThreadPoolWorker_t* m_pWorkers;      // ISTDLIB vector of workers. Never grows after init.
+    int                 m_nWorkers;      // Worker count, including the owner thread.
+
+    atomic_int          m_nQueuedTasks;  // Tasks sitting in any deque.
+    atomic_int          m_nSleepers;     // Workers blocked on m_wakeUp.
+    atomic_bool         m_bShutdown;
+
+    pthread_mutex_t     m_sleepMutex;
+    pthread_cond_t      m_wakeUp;
+
+} ThreadPool_t;
+
+
+/* Initialize pool with NWORKERS workers ( owner thread included ). NWORKERS <= 0 uses all online cores.
+ * Pool must not move in memory after this. Returns false if any worker thread fails to start. */
+static bool ThreadPool_Initialize(ThreadPool_t* pPool, int nWorkers);
+
+/* Stop & join all worker threads and free everything. No tasks may be in flight. */
+static void ThreadPool_Free(ThreadPool_t* pPool);
+
+/* Stop & join workers 1 .. NTHREADS - 1 ( the ones that were started ) and free everything. */
+static void ThreadPool_Shutdown(ThreadPool_t* pPool, int nThreads);
+
+/* Number of workers, including the owner thread. */
+static int ThreadPool_WorkerCount(ThreadPool_t* pPool);
+
+/* Scratch ArenaAllocator of worker IWORKERINDEX. Only that worker may use it, clearing it is up to the caller. */
+static ArenaAllocator_t* ThreadPool_Scratch(ThreadPool_t* pPool, int iWorkerIndex);
+
+/* Push a task on the calling worker's deque. Runs the task inline if the deque is full. */
+static void ThreadPool_Submit(ThreadPool_t* pPool, int iWorkerIndex, ThreadPoolTaskFn_t pFunction, void* pContext, ThreadPoolCounter_t* pCounter);
+
+/* Run queued tasks ( own first, then stolen ) until every task submitted against PCOUNTER is done. */
+static void ThreadPool_Wait(ThreadPool_t* pPool, int iWorkerIndex, ThreadPoolCounter_t* pCounter);
+
+/* Pop newest task from own deque, or steal oldest task from someone else. Returns false if nothing found. */
+static bool ThreadPool_FindTask(ThreadPool_t* pPool, int iWorkerIndex, ThreadPoolTask_t* pTaskOut);
+
+/* Call PFUNCTION over [0, NCOUNT) split in ranges of at most NGRAIN elements. NGRAIN <= 0 picks one. */
+static void ThreadPool_ParallelFor(ThreadPool_t* pPool, int iWorkerIndex, void* pContainer, int nCount, int nGrain,
+        ThreadPoolRangeFn_t pFunction, void* pContext);
+
+/* Reduce [0, NCOUNT) into PRESULT. PRESULT holds the identity on input, so each range starts from a copy of it. */
+static void ThreadPool_ParallelReduce(ThreadPool_t* pPool, int iWorkerIndex, void* pContainer, int nCount, int nGrain,
+        void* pResult, size_t iResultSize, ThreadPoolReduceFn_t pReduce, ThreadPoolCombineFn_t pCombine, void* pContext);
+
+/* Stable merge sort of NCOUNT elements of IELEMENTSIZE bytes each. Mallocs one temporary buffer of the same size. */
+static bool ThreadPool_ParallelSort(ThreadPool_t* pPool, int iWorkerIndex, void* pContainer, int nCount, size_t iElementSize,
+        ThreadPoolCompareFn_t pCompare);
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_RunTask(ThreadPoolTask_t* pTask, int iWorkerIndex)
+{
+    pTask->m_pFunction(pTask->m_pContext, iWorkerIndex);
+    atomic_fetch_sub_explicit(&pTask->m_pCounter->m_nPending, 1, memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void* ThreadPool_WorkerMain(void* pArgs)
+{
+    ThreadPoolWorker_t* pWorker = (ThreadPoolWorker_t*)pArgs;
+    ThreadPool_t*       pPool   = pWorker->m_pPool;
+
+    int nFailedRounds = 0;
+    while(atomic_load(&pPool->m_bShutdown) == false)
+    {
+        ThreadPoolTask_t task;
+        if(ThreadPool_FindTask(pPool, pWorker->m_iIndex, &task) == true)
+        {
+            ThreadPool_RunTask(&task, pWorker->m_iIndex);
+            nFailedRounds = 0;
+            continue;
+        }
+
+        if(++nFailedRounds < THREADPOOL_SPIN_COUNT)
+        {
+            sched_yield();
+            continue;
+        }
+
+
+        // Nothing to do for a while, sleep. Submitter bumps m_nQueuedTasks before it reads
+        // m_nSleepers, we bump m_nSleepers before we read m_nQueuedTasks, so one of us sees the other.
+        pthread_mutex_lock(&pPool->m_sleepMutex);
+        atomic_fetch_add(&pPool->m_nSleepers, 1);
+
+        while(atomic_load(&pPool->m_nQueuedTasks) == 0 && atomic_load(&pPool->m_bShutdown) == false)
+            pthread_cond_wait(&pPool->m_wakeUp, &pPool->m_sleepMutex);
+
+        atomic_fetch_sub(&pPool->m_nSleepers, 1);
+        pthread_mutex_unlock(&pPool->m_sleepMutex);
+
+        nFailedRounds = 0;
+    }
+
+    return nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool ThreadPool_Initialize(ThreadPool_t* pPool, int nWorkers)
+{
+    if(nWorkers <= 0)
+        nWorkers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    if(nWorkers <= 0)
+        nWorkers = 1;
+
+
+    pPool->m_pWorkers = NULL;
+    pPool->m_nWorkers = nWorkers;
+    atomic_init(&pPool->m_nQueuedTasks, 0);
+    atomic_init(&pPool->m_nSleepers,    0);
+    atomic_init(&pPool->m_bShutdown,    false);
+
+    pthread_mutex_init(&pPool->m_sleepMutex, NULL);
+    pthread_cond_init (&pPool->m_wakeUp,     NULL);
+
+
+    // Workers are never pushed back after this, so pointers to them stay valid.
+    Vector_Resize(pPool->m_pWorkers, nWorkers);
+    for(int iWorkerIndex = 0; iWorkerIndex < nWorkers; iWorkerIndex++)
+    {
+        ThreadPoolWorker_t* pWorker = &pPool->m_pWorkers[iWorkerIndex];
+
+        atomic_init(&pWorker->m_iTop,    0);
+        atomic_init(&pWorker->m_iBottom, 0);
+        pWorker->m_pPool   = pPool;
+        pWorker->m_iIndex  = iWorkerIndex;
+        pthread_mutex_init(&pWorker->m_mutex, NULL);
+
+        bool bScratchInitialized = ArenaAllocator_Initialize(&pWorker->m_scratch, 1, THREADPOOL_SCRATCH_SIZE);
+        assertion(bScratchInitialized == true && "Failed to initialize worker scratch arena");
+    }
+
+
+    // Worker 0 is the calling thread, spawn the rest.
+    for(int iWorkerIndex = 1; iWorkerIndex < nWorkers; iWorkerIndex++)
+    {
+        ThreadPoolWorker_t* pWorker = &pPool->m_pWorkers[iWorkerIndex];
+
+        if(pthread_create(&pWorker->m_thread, NULL, ThreadPool_WorkerMain, pWorker) != 0)
+        {
+            // Running workers read m_nWorkers, so don't shrink it under them. Stop the ones we started instead.
+            ThreadPool_Shutdown(pPool, iWorkerIndex);
+            return false;
+        }
+    }
+
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_Free(ThreadPool_t* pPool)
+{
+    assertion(atomic_load(&pPool->m_nQueuedTasks) == 0 && "Freeing thread pool with tasks still queued");
+
+    ThreadPool_Shutdown(pPool, pPool->m_nWorkers);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_Shutdown(ThreadPool_t* pPool, int nThreads)
+{
+    // Wake everyone up & let them leave.
+    pthread_mutex_lock(&pPool->m_sleepMutex);
+    atomic_store(&pPool->m_bShutdown, true);
+    pthread_cond_broadcast(&pPool->m_wakeUp);
+    pthread_mutex_unlock(&pPool->m_sleepMutex);
+
+    for(int iWorkerIndex = 1; iWorkerIndex < nThreads; iWorkerIndex++)
+    {
+        pthread_join(pPool->m_pWorkers[iWorkerIndex].m_thread, NULL);
+    }
+
+
+    for(int iWorkerIndex = 0; iWorkerIndex < Vector_Len(pPool->m_pWorkers); iWorkerIndex++)
+    {
+        ThreadPoolWorker_t* pWorker = &pPool->m_pWorkers[iWorkerIndex];
+
+        pthread_mutex_destroy(&pWorker->m_mutex);
+        ArenaAllocator_Free(&pWorker->m_scratch);
+    }
+
+    Vector_Free(pPool->m_pWorkers);
+    pthread_mutex_destroy(&pPool->m_sleepMutex);
+    pthread_cond_destroy (&pPool->m_wakeUp);
+
+    pPool->m_nWorkers = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static int ThreadPool_WorkerCount(ThreadPool_t* pPool)
+{
+    return pPool->m_nWorkers;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static ArenaAllocator_t* ThreadPool_Scratch(ThreadPool_t* pPool, int iWorkerIndex)
+{
+    assertion(iWorkerIndex >= 0 && iWorkerIndex < pPool->m_nWorkers && "Invalid worker index");
+    return &pPool->m_pWorkers[iWorkerIndex].m_scratch;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_Submit(ThreadPool_t* pPool, int iWorkerIndex, ThreadPoolTaskFn_t pFunction, void* pContext, ThreadPoolCounter_t* pCounter)
+{
+    assertion(iWorkerIndex >= 0 && iWorkerIndex < pPool->m_nWorkers && "Invalid worker index");
+
+    ThreadPoolTask_t task = { pFunction, pContext, pCounter };
+    atomic_fetch_add_explicit(&pCounter->m_nPending, 1, memory_order_relaxed);
+
+
+    // Push at the bottom of our own deque.
+    ThreadPoolWorker_t* pWorker = &pPool->m_pWorkers[iWorkerIndex];
+    bool                bPushed = false;
+
+    pthread_mutex_lock(&pWorker->m_mutex);
+    int64_t iTop    = atomic_load_explicit(&pWorker->m_iTop,    memory_order_relaxed);
+    int64_t iBottom = atomic_load_explicit(&pWorker->m_iBottom, memory_order_relaxed);
+    if(iBottom - iTop < THREADPOOL_DEQUE_CAPACITY)
+    {
+        pWorker->m_aTasks[iBottom & (THREADPOOL_DEQUE_CAPACITY - 1)] = task;
+        atomic_store_explicit(&pWorker->m_iBottom, iBottom + 1, memory_order_relaxed);
+        bPushed = true;
+    }
+    pthread_mutex_unlock(&pWorker->m_mutex);
+
+
+    // Deque full, no point in queuing more. Do it ourself.
+    if(bPushed == false)
+    {
+        ThreadPool_RunTask(&task, iWorkerIndex);
+        return;
+    }
+
+
+    atomic_fetch_add(&pPool->m_nQueuedTasks, 1);
+    if(atomic_load(&pPool->m_nSleepers) > 0)
+    {
+        pthread_mutex_lock(&pPool->m_sleepMutex);
+        pthread_cond_signal(&pPool->m_wakeUp);
+        pthread_mutex_unlock(&pPool->m_sleepMutex);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_Wait(ThreadPool_t* pPool, int iWorkerIndex, ThreadPoolCounter_t* pCounter)
+{
+    // Help out instead of blocking, tasks we wait on are most likely at the bottom of our own deque.
+    while(atomic_load_explicit(&pCounter->m_nPending, memory_order_acquire) > 0)
+    {
+        ThreadPoolTask_t task;
+        if(ThreadPool_FindTask(pPool, iWorkerIndex, &task) == true)
+        {
+            ThreadPool_RunTask(&task, iWorkerIndex);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool ThreadPool_FindTask(ThreadPool_t* pPool, int iWorkerIndex, ThreadPoolTask_t* pTaskOut)
+{
+    if(atomic_load_explicit(&pPool->m_nQueuedTasks, memory_order_relaxed) == 0)
+        return false;
+
+
+    // Newest task from our own deque.
+    ThreadPoolWorker_t* pSelf = &pPool->m_pWorkers[iWorkerIndex];
+
+    pthread_mutex_lock(&pSelf->m_mutex);
+    int64_t iSelfTop    = atomic_load_explicit(&pSelf->m_iTop,    memory_order_relaxed);
+    int64_t iSelfBottom = atomic_load_explicit(&pSelf->m_iBottom, memory_order_relaxed);
+    if(iSelfBottom > iSelfTop)
+    {
+        atomic_store_explicit(&pSelf->m_iBottom, iSelfBottom - 1, memory_order_relaxed);
+        *pTaskOut = pSelf->m_aTasks[(iSelfBottom - 1) & (THREADPOOL_DEQUE_CAPACITY - 1)];
+        pthread_mutex_unlock(&pSelf->m_mutex);
+
+        atomic_fetch_sub(&pPool->m_nQueuedTasks, 1);
+        return true;
+    }
+    pthread_mutex_unlock(&pSelf->m_mutex);
+
+
+    // Oldest task from someone else's deque.
+    for(int iOffset = 1; iOffset < pPool->m_nWorkers; iOffset++)
+    {
+        ThreadPoolWorker_t* pVictim = &pPool->m_pWorkers[(iWorkerIndex + iOffset) % pPool->m_nWorkers];
+
+        // Don't bother locking empty deques. Stale reads only make us skip or retry.
+        if(atomic_load_explicit(&pVictim->m_iBottom, memory_order_relaxed) == atomic_load_explicit(&pVictim->m_iTop, memory_order_relaxed))
+            continue;
+
+        pthread_mutex_lock(&pVictim->m_mutex);
+        int64_t iTop    = atomic_load_explicit(&pVictim->m_iTop,    memory_order_relaxed);
+        int64_t iBottom = atomic_load_explicit(&pVictim->m_iBottom, memory_order_relaxed);
+        if(iBottom > iTop)
+        {
+            *pTaskOut = pVictim->m_aTasks[iTop & (THREADPOOL_DEQUE_CAPACITY - 1)];
+            atomic_store_explicit(&pVictim->m_iTop, iTop + 1, memory_order_relaxed);
+            pthread_mutex_unlock(&pVictim->m_mutex);
+
+            atomic_fetch_sub(&pPool->m_nQueuedTasks, 1);
+            return true;
+        }
+        pthread_mutex_unlock(&pVictim->m_mutex);
+    }
+
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static int ThreadPool_DefaultGrain(ThreadPool_t* pPool, int nCount)
+{
+    int nGrain = nCount / (pPool->m_nWorkers * THREADPOOL_TASKS_PER_WORKER);
+    return nGrain < THREADPOOL_MIN_GRAIN ? THREADPOOL_MIN_GRAIN : nGrain;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPoolForJob_t
+{
+    ThreadPool_t*       m_pPool;
+    void*               m_pContainer;
+    int                 m_nGrain;
+    ThreadPoolRangeFn_t m_pFunction;
+    void*               m_pContext;
+
+} ThreadPoolForJob_t;
+
+
+typedef struct ThreadPoolForRange_t
+{
+    ThreadPoolForJob_t* m_pJob;
+    int                 m_iBegin;
+    int                 m_iEnd;
+
+} ThreadPoolForRange_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_ParallelForTask(void* pContext, int iWorkerIndex)
+{
+    ThreadPoolForRange_t* pRange = (ThreadPoolForRange_t*)pContext;
+    ThreadPoolForJob_t*   pJob   = pRange->m_pJob;
+
+    int iBegin = pRange->m_iBegin;
+    int iEnd   = pRange->m_iEnd;
+
+
+    // Split in halves, hand out the right half & keep going with the left one.
+    // Right halves live on this stack frame, so we must wait for them before returning.
+    ThreadPoolCounter_t  counter;
+    ThreadPoolForRange_t aRightHalves[32];
+    int                  nRightHalves = 0;
+    atomic_init(&counter.m_nPending, 0);
+
+    while(iEnd - iBegin > pJob->m_nGrain && nRightHalves < 32)
+    {
+        int iMid = iBegin + (iEnd - iBegin) / 2;
+
+        ThreadPoolForRange_t* pRight = &aRightHalves[nRightHalves++];
+        pRight->m_pJob   = pJob;
+        pRight->m_iBegin = iMid;
+        pRight->m_iEnd   = iEnd;
+        ThreadPool_Submit(pJob->m_pPool, iWorkerIndex, ThreadPool_ParallelForTask, pRight, &counter);
+
+        iEnd = iMid;
+    }
+
+    pJob->m_pFunction(pJob->m_pContainer, iBegin, iEnd, pJob->m_pContext, iWorkerIndex);
+
+    ThreadPool_Wait(pJob->m_pPool, iWorkerIndex, &counter);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_ParallelFor(ThreadPool_t* pPool, int iWorkerIndex, void* pContainer, int nCount, int nGrain,
+        ThreadPoolRangeFn_t pFunction, void* pContext)
+{
+    if(nCount <= 0)
+        return;
+
+    ThreadPoolForJob_t job;
+    job.m_pPool      = pPool;
+    job.m_pContainer = pContainer;
+    job.m_nGrain     = nGrain > 0 ? nGrain : ThreadPool_DefaultGrain(pPool, nCount);
+    job.m_pFunction  = pFunction;
+    job.m_pContext   = pContext;
+
+    ThreadPoolForRange_t range = { &job, 0, nCount };
+    ThreadPool_ParallelForTask(&range, iWorkerIndex);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPoolReduceJob_t
+{
+    ThreadPool_t*         m_pPool;
+    void*                 m_pContainer;
+    int                   m_nGrain;
+    const void*           m_pIdentity;
+    size_t                m_iResultSize;
+    ThreadPoolReduceFn_t  m_pReduce;
+    ThreadPoolCombineFn_t m_pCombine;
+    void*                 m_pContext;
+
+} ThreadPoolReduceJob_t;
+
+
+typedef struct ThreadPoolReduceRange_t
+{
+    ThreadPoolReduceJob_t* m_pJob;
+    int                    m_iBegin;
+    int                    m_iEnd;
+    void*                  m_pAccumulator; // Result of this range is folded in here.
+
+} ThreadPoolReduceRange_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_ParallelReduceTask(void* pContext, int iWorkerIndex)
+{
+    ThreadPoolReduceRange_t* pRange = (ThreadPoolReduceRange_t*)pContext;
+    ThreadPoolReduceJob_t*   pJob   = pRange->m_pJob;
+
+    if(pRange->m_iEnd - pRange->m_iBegin <= pJob->m_nGrain)
+    {
+        pJob->m_pReduce(pJob->m_pContainer, pRange->m_iBegin, pRange->m_iEnd, pRange->m_pAccumulator, pJob->m_pContext);
+        return;
+    }
+
+
+    // Right half reduces into its own accumulator starting from identity, left half reuses ours.
+    _Alignas(16) uint8_t    aRightAccumulator[THREADPOOL_MAX_REDUCE_SIZE];
+    memcpy(aRightAccumulator, pJob->m_pIdentity, pJob->m_iResultSize);
+
+    int                     iMid  = pRange->m_iBegin + (pRange->m_iEnd - pRange->m_iBegin) / 2;
+    ThreadPoolReduceRange_t left  = { pJob, pRange->m_iBegin, iMid,            pRange->m_pAccumulator };
+    ThreadPoolReduceRange_t right = { pJob, iMid,             pRange->m_iEnd,  aRightAccumulator      };
+
+    ThreadPoolCounter_t counter;
+    atomic_init(&counter.m_nPending, 0);
+
+    ThreadPool_Submit(pJob->m_pPool, iWorkerIndex, ThreadPool_ParallelReduceTask, &right, &counter);
+    ThreadPool_ParallelReduceTask(&left, iWorkerIndex);
+    ThreadPool_Wait(pJob->m_pPool, iWorkerIndex, &counter);
+
+    pJob->m_pCombine(pRange->m_pAccumulator, aRightAccumulator, pJob->m_pContext);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_ParallelReduce(ThreadPool_t* pPool, int iWorkerIndex, void* pContainer, int nCount, int nGrain,
+        void* pResult, size_t iResultSize, ThreadPoolReduceFn_t pReduce, ThreadPoolCombineFn_t pCombine, void* pContext)
+{
+    assertion(iResultSize <= THREADPOOL_MAX_REDUCE_SIZE && "Reduction accumulator too big, bump THREADPOOL_MAX_REDUCE_SIZE");
+    if(nCount <= 0)
+        return;
+
+
+    // pResult gets written into while we go, keep the identity around.
+    _Alignas(16) uint8_t aIdentity[THREADPOOL_MAX_REDUCE_SIZE];
+    memcpy(aIdentity, pResult, iResultSize);
+
+    ThreadPoolReduceJob_t job;
+    job.m_pPool       = pPool;
+    job.m_pContainer  = pContainer;
+    job.m_nGrain      = nGrain > 0 ? nGrain : ThreadPool_DefaultGrain(pPool, nCount);
+    job.m_pIdentity   = aIdentity;
+    job.m_iResultSize = iResultSize;
+    job.m_pReduce     = pReduce;
+    job.m_pCombine    = pCombine;
+    job.m_pContext    = pContext;
+
+    ThreadPoolReduceRange_t range = { &job, 0, nCount, pResult };
+    ThreadPool_ParallelReduceTask(&range, iWorkerIndex);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct ThreadPoolSortJob_t
+{
+    ThreadPool_t*         m_pPool;
+    uint8_t*              m_pData;
+    uint8_t*              m_pTemp;  // Same size as m_pData.
+    size_t                m_iElementSize;
+    int                   m_nGrain;
+    ThreadPoolCompareFn_t m_pCompare;
+
+} ThreadPoolSortJob_t;
+
+
+typedef struct ThreadPoolSortRange_t
+{
+    ThreadPoolSortJob_t* m_pJob;
+    int                  m_iBegin;
+    int                  m_iEnd;
+
+} ThreadPoolSortRange_t;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_InsertionSort(uint8_t* pData, int nCount, size_t iElementSize, ThreadPoolCompareFn_t pCompare, uint8_t* pSwap)
+{
+    for(int i = 1; i < nCount; i++)
+    {
+        int j = i;
+        memcpy(pSwap, pData + i * iElementSize, iElementSize);
+
+        while(j > 0 && pCompare(pData + (j - 1) * iElementSize, pSwap) > 0)
+        {
+            memcpy(pData + j * iElementSize, pData + (j - 1) * iElementSize, iElementSize);
+            j--;
+        }
+
+        memcpy(pData + j * iElementSize, pSwap, iElementSize);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void ThreadPool_ParallelSortTask(void* pContext, int iWorkerIndex)
+{
+    ThreadPoolSortRange_t* pRange       = (ThreadPoolSortRange_t*)pContext;
+    ThreadPoolSortJob_t*   pJob         = pRange->m_pJob;
+    size_t                 iElementSize = pJob->m_iElementSize;
+    int                    nCount       = pRange->m_iEnd - pRange->m_iBegin;
+
+    uint8_t* pData = pJob->m_pData + (size_t)pRange->m_iBegin * iElementSize;
+    uint8_t* pTemp = pJob->m_pTemp + (size_t)pRange->m_iBegin * iElementSize;
+
+
+    // Small range, insertion sort in place. Temp buffer of this range is free to use as swap space.
+    if(nCount <= 32)
+    {
+        ThreadPool_InsertionSort(pData, nCount, iElementSize, pJob->m_pCompare, pTemp);
+        return;
+    }
+
+
+    // Sort both halves, right one possibly on someone else.
+    int                   iMid  = pRange->m_iBegin + nCount / 2;
+    ThreadPoolSortRange_t left  = { pJob, pRange->m_iBegin, iMid           };
+    ThreadPoolSortRange_t right = { pJob, iMid,             pRange->m_iEnd };
+
+    if(nCount > pJob->m_nGrain)
+    {
+        ThreadPoolCounter_t counter;
+        atomic_init(&counter.m_nPending, 0);
+
+        ThreadPool_Submit(pJob->m_pPool, iWorkerIndex, ThreadPool_ParallelSortTask, &right, &counter);
+        ThreadPool_ParallelSortTask(&left, iWorkerIndex);
+        ThreadPool_Wait(pJob->m_pPool, iWorkerIndex, &counter);
+    }
+    else
+    {
+        ThreadPool_ParallelSortTask(&left,  iWorkerIndex);
+        ThreadPool_ParallelSortTask(&right, iWorkerIndex);
+    }
+
+
+    // Already in order? Happens a lot with partially sorted input.
+    uint8_t* pLeftBegin  = pData;
+    uint8_t* pLeftEnd    = pJob->m_pData + (size_t)iMid * iElementSize;
+    uint8_t* pRightBegin = pLeftEnd;
+    uint8_t* pRightEnd   = pJob->m_pData + (size_t)pRange->m_iEnd * iElementSize;
+
+    if(pJob->m_pCompare(pLeftEnd - iElementSize, pRightBegin) <= 0)
+        return;
+
+
+    // Merge into temp & copy back. Ties go left to keep it stable.
+    uint8_t* pOut = pTemp;
+    while(pLeftBegin < pLeftEnd && pRightBegin < pRightEnd)
+    {
+        if(pJob->m_pCompare(pRightBegin, pLeftBegin) < 0)
+        {
+            memcpy(pOut, pRightBegin, iElementSize);
+            pRightBegin += iElementSize;
+        }
+        else
+        {
+            memcpy(pOut, pLeftBegin, iElementSize);
+            pLeftBegin += iElementSize;
+        }
+
+        pOut += iElementSize;
+    }
+
+    memcpy(pOut, pLeftBegin, pLeftEnd - pLeftBegin);
+    pOut += pLeftEnd - pLeftBegin;
+    memcpy(pOut, pRightBegin, pRightEnd - pRightBegin);
+
+    memcpy(pData, pTemp, (size_t)nCount * iElementSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool ThreadPool_ParallelSort(ThreadPool_t* pPool, int iWorkerIndex, void* pContainer, int nCount, size_t iElementSize,
+        ThreadPoolCompareFn_t pCompare)
+{
+    if(nCount <= 1)
+        return true;
+
+    ThreadPoolSortJob_t job;
+    job.m_pPool        = pPool;
+    job.m_pData        = (uint8_t*)pContainer;
+    job.m_pTemp        = (uint8_t*)malloc((size_t)nCount * iElementSize);
+    job.m_iElementSize = iElementSize;
+    job.m_nGrain       = ThreadPool_DefaultGrain(pPool, nCount);
+    job.m_pCompare     = pCompare;
+
+    if(job.m_pTemp == nullptr)
+        return false;
+
+    ThreadPoolSortRange_t range = { &job, 0, nCount };
+    ThreadPool_ParallelSortTask(&range, iWorkerIndex);
+
+    free(job.m_pTemp);
+    return true;
+}
+
+
+#endif
@@ -19,7 +19,9 @@
 #include "ILIB_Assertion.h"
 
 
+#ifndef __cplusplus
 #define nullptr              ((void*)0)
+#endif
 #define STD_VECTOR_CAPACITY  (10)
 #define STD_VECTOR_SIGNATURE (0xBED0DECA)
 #define STD_VECTOR_GROWTH    (2)
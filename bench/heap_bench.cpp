@@ -0,0 +1,229 @@
+//=========================================================================
+//                      ILIB Heap Benchmark
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Heap_*() & KeyHeap_*() vs a sorted ILIB vector & std::priority_queue.
+//-------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+#include "../ILIB_Vector.h"
+#include "../ILIB_Heap.h"
+
+
+#define BENCH_MAX_SORTED  (100000)   // Sorted vector is O(n^2) to fill, skip it past this.
+#define BENCH_REPEATS     (3)        // Best of this many runs is reported.
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static double Bench_Now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e3 + (double)time.tv_nsec * 1e-6;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t Bench_Random(uint64_t* pState)
+{
+    // xorshift64*, good enough for test data.
+    *pState ^= *pState >> 12;
+    *pState ^= *pState << 25;
+    *pState ^= *pState >> 27;
+    return *pState * 2685821657736338717ULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static int Bench_CompareKeys(const void* pLeft, const void* pRight)
+{
+    int64_t iLeft  = *(const int64_t*)pLeft;
+    int64_t iRight = *(const int64_t*)pRight;
+    return (iLeft > iRight) - (iLeft < iRight);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+/* Push every key, then pop them all. Returns sum of popped keys weighted by order, same for every queue. */
+static int64_t Bench_Heap(const int64_t* pKeys, uint32_t nKeys)
+{
+    Heap_t heap;
+    Heap_Initialize(&heap, sizeof(int64_t), STD_HEAP_ARITY, Bench_CompareKeys, false);
+
+    for(uint32_t iIndex = 0; iIndex < nKeys; iIndex++)
+        Heap_Push(&heap, &pKeys[iIndex]);
+
+    int64_t iCheck = 0, iKey = 0;
+    for(uint32_t iIndex = 0; Heap_Pop(&heap, &iKey) == true; iIndex++)
+        iCheck += iKey * (int64_t)(iIndex & 7);
+
+    Heap_Free(&heap);
+    return iCheck;
+}
+
+
+static int64_t Bench_KeyHeap(const int64_t* pKeys, uint32_t nKeys)
+{
+    int64_t* pHeap = nullptr;
+    Vector_Reserve(pHeap, nKeys);
+
+    for(uint32_t iIndex = 0; iIndex < nKeys; iIndex++)
+        KeyHeap_Push(&pHeap, pKeys[iIndex]);
+
+    int64_t iCheck = 0;
+    for(uint32_t iIndex = 0; Vector_Len(pHeap) > 0; iIndex++)
+        iCheck += KeyHeap_Pop(pHeap) * (int64_t)(iIndex & 7);
+
+    Vector_Free(pHeap);
+    return iCheck;
+}
+
+
+static int64_t Bench_KeyHeapify(const int64_t* pKeys, uint32_t nKeys)
+{
+    // Bulk build instead of pushing one by one.
+    int64_t* pHeap = nullptr;
+    Vector_Resize(pHeap, nKeys);
+    memcpy(pHeap, pKeys, sizeof(int64_t) * nKeys);
+    KeyHeap_Heapify(pHeap);
+
+    int64_t iCheck = 0;
+    for(uint32_t iIndex = 0; Vector_Len(pHeap) > 0; iIndex++)
+        iCheck += KeyHeap_Pop(pHeap) * (int64_t)(iIndex & 7);
+
+    Vector_Free(pHeap);
+    return iCheck;
+}
+
+
+static int64_t Bench_SortedVector(const int64_t* pKeys, uint32_t nKeys)
+{
+    // Kept in descending order, so the smallest key pops off the back.
+    int64_t* pSorted = nullptr;
+    Vector_Reserve(pSorted, nKeys);
+
+    for(uint32_t iIndex = 0; iIndex < nKeys; iIndex++)
+    {
+        int64_t  iKey  = pKeys[iIndex];
+        uint32_t iLow  = 0;
+        uint32_t iHigh = Vector_Len(pSorted);
+        while(iLow < iHigh)
+        {
+            uint32_t iMid = (iLow + iHigh) / 2;
+            if(pSorted[iMid] > iKey)
+                iLow  = iMid + 1;
+            else
+                iHigh = iMid;
+        }
+
+        Vector_Insert(pSorted, (int)iLow, iKey);
+    }
+
+    int64_t iCheck = 0;
+    for(uint32_t iIndex = 0; Vector_Len(pSorted) > 0; iIndex++)
+    {
+        iCheck += *Vector_Back(pSorted) * (int64_t)(iIndex & 7);
+        Vector_PopBack(pSorted);
+    }
+
+    Vector_Free(pSorted);
+    return iCheck;
+}
+
+
+static int64_t Bench_StdPriorityQueue(const int64_t* pKeys, uint32_t nKeys)
+{
+    std::vector<int64_t> storage;
+    storage.reserve(nKeys);
+    std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t>> queue(std::greater<int64_t>(), std::move(storage));
+
+    for(uint32_t iIndex = 0; iIndex < nKeys; iIndex++)
+        queue.push(pKeys[iIndex]);
+
+    int64_t iCheck = 0;
+    for(uint32_t iIndex = 0; queue.empty() == false; iIndex++)
+    {
+        iCheck += queue.top() * (int64_t)(iIndex & 7);
+        queue.pop();
+    }
+
+    return iCheck;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef int64_t (*BenchFn_t)(const int64_t* pKeys, uint32_t nKeys);
+
+static double Bench_Run(BenchFn_t pFunction, const int64_t* pKeys, uint32_t nKeys, int64_t iExpected)
+{
+    double fBest = 1e30;
+    for(int iRepeat = 0; iRepeat < BENCH_REPEATS; iRepeat++)
+    {
+        double  fStart = Bench_Now();
+        int64_t iCheck = pFunction(pKeys, nKeys);
+        double  fTime  = Bench_Now() - fStart;
+
+        assertion(iCheck == iExpected && "Queue popped keys in wrong order");
+        fBest = fTime < fBest ? fTime : fBest;
+    }
+
+    return fBest;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main()
+{
+    const uint32_t aSizes[] = { 1000, 10000, 100000, 1000000 };
+
+    printf("push N random int64 keys, then pop all. best of %d ( ms )\n\n", BENCH_REPEATS);
+    printf("%10s %12s %12s %12s %14s %16s\n", "N", "Heap_*", "KeyHeap_*", "KeyHeapify", "sorted vector", "priority_queue");
+
+    uint64_t iState = 0x9E3779B97F4A7C15ULL;
+    for(uint32_t iSize = 0; iSize < sizeof(aSizes) / sizeof(aSizes[0]); iSize++)
+    {
+        uint32_t nKeys = aSizes[iSize];
+
+        int64_t* pKeys = nullptr;
+        Vector_Resize(pKeys, nKeys);
+        for(uint32_t iIndex = 0; iIndex < nKeys; iIndex++)
+            pKeys[iIndex] = (int64_t)(Bench_Random(&iState) >> 1);
+
+        int64_t iExpected = Bench_StdPriorityQueue(pKeys, nKeys);
+
+        printf("%10u %12.3f %12.3f %12.3f ", nKeys,
+                Bench_Run(Bench_Heap,       pKeys, nKeys, iExpected),
+                Bench_Run(Bench_KeyHeap,    pKeys, nKeys, iExpected),
+                Bench_Run(Bench_KeyHeapify, pKeys, nKeys, iExpected));
+
+        if(nKeys <= BENCH_MAX_SORTED)
+            printf("%14.3f ", Bench_Run(Bench_SortedVector, pKeys, nKeys, iExpected));
+        else
+            printf("%14s ", "skipped");
+
+        printf("%16.3f\n", Bench_Run(Bench_StdPriorityQueue, pKeys, nKeys, iExpected));
+
+        Vector_Free(pKeys);
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+//=========================================================================
+//                      ILIB SoA Benchmark
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Field scans over SoA_t columns vs an array-of-structs ILIB
+//           vector of 64 byte records.
+//-------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../ILIB_Vector.h"
+#include "../ILIB_SoA.h"
+
+
+#define BENCH_ROWS     (1024 * 1024 * 4)
+#define BENCH_REPEATS  (10)   // Best of this many runs is reported.
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+typedef struct BenchRecord_t
+{
+    float    m_fPosX, m_fPosY, m_fPosZ;
+    float    m_fVelX, m_fVelY, m_fVelZ;
+    float    m_fMass;
+    float    m_fRadius;
+    uint64_t m_iId;
+    uint64_t m_iFlags;
+    uint8_t  m_aPad[16];
+
+} BenchRecord_t;
+
+
+// SoA columns, same fields as BenchRecord_t.
+enum
+{
+    BENCH_COL_POSX, BENCH_COL_POSY, BENCH_COL_POSZ,
+    BENCH_COL_VELX, BENCH_COL_VELY, BENCH_COL_VELZ,
+    BENCH_COL_MASS, BENCH_COL_RADIUS,
+    BENCH_COL_ID,   BENCH_COL_FLAGS,
+    BENCH_COL_COUNT
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static double Bench_Now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e3 + (double)time.tv_nsec * 1e-6;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main()
+{
+    _Static_assert(sizeof(BenchRecord_t) == 64, "Bench record should be one cache line");
+
+
+    // Same data in both layouts.
+    BenchRecord_t* pRecords = nullptr;
+    Vector_Resize(pRecords, BENCH_ROWS);
+
+    size_t aElementSizes[BENCH_COL_COUNT] = {
+        sizeof(float), sizeof(float), sizeof(float),
+        sizeof(float), sizeof(float), sizeof(float),
+        sizeof(float), sizeof(float),
+        sizeof(uint64_t), sizeof(uint64_t) };
+
+    SoA_t soa;
+    SoA_Initialize(&soa, BENCH_COL_COUNT, aElementSizes);
+    SoA_Resize(&soa, BENCH_ROWS);
+
+    float*    pPosX  = SoA_Column(&soa, float,    BENCH_COL_POSX);
+    float*    pVelX  = SoA_Column(&soa, float,    BENCH_COL_VELX);
+    float*    pMass  = SoA_Column(&soa, float,    BENCH_COL_MASS);
+    uint64_t* pIds   = SoA_Column(&soa, uint64_t, BENCH_COL_ID);
+
+    for(int iRow = 0; iRow < BENCH_ROWS; iRow++)
+    {
+        BenchRecord_t record = {0};
+        record.m_fPosX = (float)(iRow & 255);
+        record.m_fVelX = 1.0f;
+        record.m_fMass = (float)(iRow % 7);
+        record.m_iId   = (uint64_t)iRow;
+        pRecords[iRow] = record;
+
+        pPosX[iRow] = record.m_fPosX;
+        pVelX[iRow] = record.m_fVelX;
+        pMass[iRow] = record.m_fMass;
+        pIds [iRow] = record.m_iId;
+    }
+
+    printf("%d rows, %zu byte records, best of %d ( ms )\n\n", BENCH_ROWS, sizeof(BenchRecord_t), BENCH_REPEATS);
+    printf("%-32s %10s %10s %8s\n", "scan", "AoS", "SoA", "speedup");
+
+
+    double fBestAoS[2] = { 1e30, 1e30 };
+    double fBestSoA[2] = { 1e30, 1e30 };
+    double fCheck      = 0.0;
+    for(int iRepeat = 0; iRepeat < BENCH_REPEATS; iRepeat++)
+    {
+        // One field : sum of mass.
+        double fStart = Bench_Now();
+        float  fSum   = 0.0f;
+        for(int iRow = 0; iRow < Vector_Len(pRecords); iRow++)
+            fSum += pRecords[iRow].m_fMass;
+        double fTime  = Bench_Now() - fStart;
+        fBestAoS[0]   = fTime < fBestAoS[0] ? fTime : fBestAoS[0];
+        fCheck       += fSum;
+
+        fStart = Bench_Now();
+        fSum   = 0.0f;
+        for(uint32_t iRow = 0; iRow < SoA_Len(&soa); iRow++)
+            fSum += pMass[iRow];
+        fTime       = Bench_Now() - fStart;
+        fBestSoA[0] = fTime < fBestSoA[0] ? fTime : fBestSoA[0];
+        fCheck     -= fSum;
+
+
+        // Two fields : integrate position.
+        fStart = Bench_Now();
+        for(int iRow = 0; iRow < Vector_Len(pRecords); iRow++)
+            pRecords[iRow].m_fPosX += pRecords[iRow].m_fVelX * 0.016f;
+        fTime       = Bench_Now() - fStart;
+        fBestAoS[1] = fTime < fBestAoS[1] ? fTime : fBestAoS[1];
+
+        fStart = Bench_Now();
+        for(uint32_t iRow = 0; iRow < SoA_Len(&soa); iRow++)
+            pPosX[iRow] += pVelX[iRow] * 0.016f;
+        fTime       = Bench_Now() - fStart;
+        fBestSoA[1] = fTime < fBestSoA[1] ? fTime : fBestSoA[1];
+    }
+
+
+    // Both layouts must have done the same work.
+    for(int iRow = 0; iRow < BENCH_ROWS; iRow++)
+        assertion(pRecords[iRow].m_fPosX == pPosX[iRow] && "AoS & SoA results differ");
+
+    const char* aNames[2] = { "sum 1 field ( mass )", "update 2 fields ( pos += vel )" };
+    for(int iScan = 0; iScan < 2; iScan++)
+        printf("%-32s %10.2f %10.2f %7.2fx\n", aNames[iScan], fBestAoS[iScan], fBestSoA[iScan], fBestAoS[iScan] / fBestSoA[iScan]);
+
+    // Keeps the sums from being optimized away, should be 0.
+    printf("\nchecksum %.0f\n", fCheck);
+
+    Vector_Free(pRecords);
+    SoA_Free(&soa);
+    return 0;
+}
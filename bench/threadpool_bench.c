@@ -0,0 +1,169 @@
+//=========================================================================
+//                      ILIB Thread Pool Benchmark
+//=========================================================================
+// by      : INSANE
+// created : 19/10/2026
+//
+// purpose : Scaling of Vector_ParallelFor / Reduce / Sort from 1 worker
+//           up to every online core.
+//-------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../ILIB_ThreadPool.h"
+
+
+#define BENCH_ELEMENTS    (1024 * 1024 * 16)  // Elements in for / reduce vectors.
+#define BENCH_SORT_ELEMS  (1024 * 1024 * 4)   // Elements in sort vector.
+#define BENCH_REPEATS     (5)                 // Best of this many runs is reported.
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static double Bench_Now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e3 + (double)time.tv_nsec * 1e-6;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t Bench_Random(uint64_t* pState)
+{
+    // xorshift64*, good enough for test data.
+    *pState ^= *pState >> 12;
+    *pState ^= *pState << 25;
+    *pState ^= *pState >> 27;
+    return *pState * 2685821657736338717ULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Bench_ForRange(void* pContainer, int iBegin, int iEnd, void* pContext, int iWorkerIndex)
+{
+    // A bit of math per element, so we are not purely memory bound.
+    float* pData = (float*)pContainer;
+    for(int iIndex = iBegin; iIndex < iEnd; iIndex++)
+        pData[iIndex] = pData[iIndex] * 0.999f + sqrtf((float)iIndex);
+}
+
+
+static void Bench_ReduceRange(void* pContainer, int iBegin, int iEnd, void* pAccumulator, void* pContext)
+{
+    float*  pData = (float*)pContainer;
+    double* pSum  = (double*)pAccumulator;
+    for(int iIndex = iBegin; iIndex < iEnd; iIndex++)
+        *pSum += (double)pData[iIndex];
+}
+
+
+static void Bench_ReduceCombine(void* pAccumulator, const void* pOther, void* pContext)
+{
+    *(double*)pAccumulator += *(const double*)pOther;
+}
+
+
+static int Bench_CompareU64(const void* pLeft, const void* pRight)
+{
+    uint64_t iLeft  = *(const uint64_t*)pLeft;
+    uint64_t iRight = *(const uint64_t*)pRight;
+    return (iLeft > iRight) - (iLeft < iRight);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(int nArgs, char** ppArgs)
+{
+    // Optional argument overrides the max worker count.
+    int nCores = nArgs > 1 ? atoi(ppArgs[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if(nCores < 1)
+        nCores = 1;
+
+    float*    pFloats   = nullptr;
+    uint64_t* pUnsorted = nullptr;
+    uint64_t* pSorted   = nullptr;
+    Vector_Resize(pFloats,   BENCH_ELEMENTS);
+    Vector_Resize(pUnsorted, BENCH_SORT_ELEMS);
+    Vector_Resize(pSorted,   BENCH_SORT_ELEMS);
+
+    uint64_t iState = 0x9E3779B97F4A7C15ULL;
+    for(int iIndex = 0; iIndex < BENCH_SORT_ELEMS; iIndex++)
+        pUnsorted[iIndex] = Bench_Random(&iState);
+
+    printf("1..%d workers, %d elements for / reduce, %d elements sort, best of %d ( ms )\n\n",
+            nCores, BENCH_ELEMENTS, BENCH_SORT_ELEMS, BENCH_REPEATS);
+    printf("%8s %10s %8s %10s %8s %10s %8s\n", "workers", "for", "speedup", "reduce", "speedup", "sort", "speedup");
+
+
+    double fBaseFor = 0.0, fBaseReduce = 0.0, fBaseSort = 0.0;
+    double fCheck   = 0.0;
+    for(int nWorkers = 1; nWorkers <= nCores; nWorkers++)
+    {
+        ThreadPool_t pool;
+        if(ThreadPool_Initialize(&pool, nWorkers) == false)
+        {
+            printf("Failed to start pool with %d workers\n", nWorkers);
+            return 1;
+        }
+
+        double fBestFor = 1e30, fBestReduce = 1e30, fBestSort = 1e30;
+        for(int iRepeat = 0; iRepeat < BENCH_REPEATS; iRepeat++)
+        {
+            for(int iIndex = 0; iIndex < BENCH_ELEMENTS; iIndex++)
+                pFloats[iIndex] = (float)(iIndex & 1023);
+
+            double fStart = Bench_Now();
+            Vector_ParallelFor(&pool, pFloats, Bench_ForRange, nullptr);
+            double fTime  = Bench_Now() - fStart;
+            fBestFor      = fTime < fBestFor ? fTime : fBestFor;
+
+            double fSum = 0.0;
+            fStart      = Bench_Now();
+            Vector_ParallelReduce(&pool, pFloats, &fSum, Bench_ReduceRange, Bench_ReduceCombine, nullptr);
+            fTime       = Bench_Now() - fStart;
+            fBestReduce = fTime < fBestReduce ? fTime : fBestReduce;
+            fCheck     += fSum;
+
+            memcpy(pSorted, pUnsorted, sizeof(uint64_t) * BENCH_SORT_ELEMS);
+            fStart      = Bench_Now();
+            Vector_ParallelSort(&pool, pSorted, Bench_CompareU64);
+            fTime       = Bench_Now() - fStart;
+            fBestSort   = fTime < fBestSort ? fTime : fBestSort;
+        }
+
+        ThreadPool_Free(&pool);
+
+        for(int iIndex = 1; iIndex < BENCH_SORT_ELEMS; iIndex++)
+            assertion(pSorted[iIndex - 1] <= pSorted[iIndex] && "Parallel sort output is not sorted");
+
+        if(nWorkers == 1)
+        {
+            fBaseFor    = fBestFor;
+            fBaseReduce = fBestReduce;
+            fBaseSort   = fBestSort;
+        }
+
+        printf("%8d %10.2f %7.2fx %10.2f %7.2fx %10.2f %7.2fx\n", nWorkers,
+                fBestFor,    fBaseFor    / fBestFor,
+                fBestReduce, fBaseReduce / fBestReduce,
+                fBestSort,   fBaseSort   / fBestSort);
+    }
+
+    // Keeps the reduce from being optimized away.
+    printf("\nchecksum %.0f\n", fCheck);
+
+    Vector_Free(pFloats);
+    Vector_Free(pUnsorted);
+    Vector_Free(pSorted);
+    return 0;
+}